@@ -8,7 +8,7 @@
 # .. code-block:: cmake
 #
 #    usFunctionAddResources(TARGET target [BUNDLE_NAME bundle_name]
-#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level]
+#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level] [BINARY_MANIFEST]
 #      [FILES res1...] [ZIP_ARCHIVES archive1...])
 #
 # This CMake function uses an external command line program to generate a ZIP archive
@@ -33,6 +33,10 @@
 #                           FILES config.properties logo.png
 #                          )
 #
+# **Options**
+#    * ``BINARY_MANIFEST``: Also add a pre-parsed binary form of the bundle's manifest.json
+#      (manifest.bin), which the framework loads on install instead of parsing the JSON.
+#
 # **One-value keywords**
 #    * ``TARGET`` (required): The target to which the resource files are added.
 #    * ``BUNDLE_NAME`` (required/optional): The bundle name of the target, as specified in
@@ -60,7 +64,7 @@
 #
 function(usFunctionAddResources)
 
-  cmake_parse_arguments(US_RESOURCE "" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
+  cmake_parse_arguments(US_RESOURCE "BINARY_MANIFEST" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
 
   if(NOT US_RESOURCE_TARGET)
     message(SEND_ERROR "TARGET argument not specified.")
@@ -85,9 +89,13 @@ function(usFunctionAddResources)
     set(US_RESOURCE_WORKING_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}/${US_RESOURCE_WORKING_DIRECTORY}")
   endif()
 
-  if(US_RESOURCE_COMPRESSION_LEVEL)
+  # Level 0 is valid (store uncompressed), so test for emptiness instead of truthiness.
+  if(NOT "${US_RESOURCE_COMPRESSION_LEVEL}" STREQUAL "")
     set(cmd_line_args -c ${US_RESOURCE_COMPRESSION_LEVEL})
   endif()
+  if(US_RESOURCE_BINARY_MANIFEST)
+    list(APPEND cmd_line_args --binary-manifest)
+  endif()
 
   if(CMAKE_CROSSCOMPILING)
     # Cross-compiled builds need to use the imported host version of usResourceCompiler
@@ -21,13 +21,19 @@ macro(_us_create_test_bundle_helper)
   
   target_link_libraries(${name} ${${PROJECT_NAME}_TARGET} ${US_TEST_LINK_LIBRARIES} ${US_TEST_OTHER_LIBRARIES} CppMicroServices)
 
+  set(_binary_manifest )
+  if(US_TEST_BINARY_MANIFEST)
+    set(_binary_manifest BINARY_MANIFEST)
+  endif()
   if(_res_files OR US_TEST_LINK_LIBRARIES)
-    usFunctionAddResources(TARGET ${name} WORKING_DIRECTORY ${_res_root}
+    usFunctionAddResources(TARGET ${name} WORKING_DIRECTORY ${_res_root} ${_binary_manifest}
+                           ${_compression_level}
                            FILES ${_res_files}
                            ZIP_ARCHIVES ${US_TEST_LINK_LIBRARIES})
   endif()
   if(_bin_res_files)
     usFunctionAddResources(TARGET ${name} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/resources
+                           ${_compression_level}
                            FILES ${_bin_res_files})
   endif()
 
@@ -43,13 +49,14 @@ function(usFunctionCreateTestBundle name)
   set(_srcs ${ARGN})
   set(_res_files )
   set(_bin_res_files )
+  set(_compression_level )
   set(_bundle_symbolic_name ${name})
   usFunctionGenerateBundleInit(TARGET ${name} OUT _srcs)
   _us_create_test_bundle_helper()
 endfunction()
 
 function(usFunctionCreateTestBundleWithResources name)
-  cmake_parse_arguments(US_TEST "SKIP_BUNDLE_LIST;LINK_RESOURCES;APPEND_RESOURCES" "RESOURCES_ROOT;LIBRARY_EXTENSION;BUNDLE_SYMBOLIC_NAME" "SOURCES;RESOURCES;BINARY_RESOURCES;LINK_LIBRARIES;OTHER_LIBRARIES" "" ${ARGN})
+  cmake_parse_arguments(US_TEST "SKIP_BUNDLE_LIST;LINK_RESOURCES;APPEND_RESOURCES;BINARY_MANIFEST" "RESOURCES_ROOT;LIBRARY_EXTENSION;BUNDLE_SYMBOLIC_NAME;COMPRESSION_LEVEL" "SOURCES;RESOURCES;BINARY_RESOURCES;LINK_LIBRARIES;OTHER_LIBRARIES" "" ${ARGN})
 
   if(US_TEST_BUNDLE_SYMBOLIC_NAME)
     set(_bundle_symbolic_name ${US_TEST_BUNDLE_SYMBOLIC_NAME})
@@ -68,6 +75,10 @@ function(usFunctionCreateTestBundleWithResources name)
   usFunctionGetResourceSource(TARGET ${name} OUT _srcs ${_mode})
   set(_res_files ${US_TEST_RESOURCES})
   set(_bin_res_files ${US_TEST_BINARY_RESOURCES})
+  set(_compression_level )
+  if(NOT "${US_TEST_COMPRESSION_LEVEL}" STREQUAL "")
+    set(_compression_level COMPRESSION_LEVEL ${US_TEST_COMPRESSION_LEVEL})
+  endif()
   if(US_TEST_RESOURCES_ROOT)
     set(_res_root ${US_TEST_RESOURCES_ROOT})
   else()
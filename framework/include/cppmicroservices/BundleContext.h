@@ -312,6 +312,32 @@ namespace cppmicroservices
         [[nodiscard]] ServiceRegistrationU RegisterService(InterfaceMapConstPtr const& service,
                                                            ServiceProperties const& properties = ServiceProperties());
 
+        /**
+         * Registers the specified service object with the specified properties
+         * under the specified class names into the framework, taking ownership of
+         * \c properties.
+         *
+         * This is identical to RegisterService(const InterfaceMap&, const ServiceProperties&),
+         * except that the properties are moved into the service registry instead of
+         * being copied. Use it for registration-heavy code which builds a fresh
+         * ServiceProperties object per registration.
+         *
+         * @param service A shared_ptr to a map of interface identifiers to service objects.
+         * @param properties The properties for this service.
+         * @return A <code>ServiceRegistration</code> object for use by the bundle
+         *         registering the service to update the service's properties or to
+         *         unregister the service.
+         *
+         * @throws std::runtime_error If this BundleContext is no longer valid, or if there are
+                   case variants of the same key in the supplied properties map.
+         * @throws std::invalid_argument If the InterfaceMap is empty, or
+         *         if a service is registered as a null class.
+         *
+         * @see RegisterService(const InterfaceMap&, const ServiceProperties&)
+         */
+        [[nodiscard]] ServiceRegistrationU RegisterService(InterfaceMapConstPtr const& service,
+                                                           ServiceProperties&& properties);
+
         /**
          * Registers the specified service object with the specified properties
          * using the specified interfaces types with the framework.
@@ -347,6 +373,20 @@ namespace cppmicroservices
             return RegisterService(servicePointers, properties);
         }
 
+        /**
+         * Same as RegisterService(std::shared_ptr<Impl> const&, const ServiceProperties&), but moves
+         * \c properties into the service registry instead of copying them.
+         *
+         * @see RegisterService(const InterfaceMap&, ServiceProperties&&)
+         */
+        template <class I1, class... Interfaces, class Impl>
+        ServiceRegistration<I1, Interfaces...>
+        RegisterService(std::shared_ptr<Impl> const& impl, ServiceProperties&& properties)
+        {
+            InterfaceMapConstPtr servicePointers = MakeInterfaceMap<I1, Interfaces...>(impl);
+            return RegisterService(servicePointers, std::move(properties));
+        }
+
         /**
          * Registers the specified service factory as a service with the specified properties
          * using the specified template argument as service interface type with the framework.
@@ -383,6 +423,20 @@ namespace cppmicroservices
             return RegisterService(servicePointers, properties);
         }
 
+        /**
+         * Same as RegisterService(std::shared_ptr<ServiceFactory> const&, const ServiceProperties&), but
+         * moves \c properties into the service registry instead of copying them.
+         *
+         * @see RegisterService(const InterfaceMap&, ServiceProperties&&)
+         */
+        template <class I1, class... Interfaces>
+        ServiceRegistration<I1, Interfaces...>
+        RegisterService(std::shared_ptr<ServiceFactory> const& factory, ServiceProperties&& properties)
+        {
+            InterfaceMapConstPtr servicePointers = MakeInterfaceMap<I1, Interfaces...>(factory);
+            return RegisterService(servicePointers, std::move(properties));
+        }
+
         /**
          * Returns a list of <code>ServiceReference</code> objects ordered
          * by rank. The returned list contains services that were registered under
@@ -572,7 +626,8 @@ namespace cppmicroservices
          * object is cached by the framework. While the context bundle's use count
          * for the service is greater than zero, subsequent calls to get the
          * services's service object for the context bundle will return the cached
-         * service object. <br>
+         * service object. Calls from other threads for the context bundle block
+         * until the service object has been created. <br>
          * If the <code>ServiceFactory</code> object throws an
          * exception, empty object is returned and a warning is logged.
          * <li>A shared_ptr to the service object is returned.
@@ -1121,6 +1176,28 @@ namespace cppmicroservices
                                            cppmicroservices::AnyMap const& bundleManifest = cppmicroservices::AnyMap(
                                                cppmicroservices::any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
 
+        /**
+         * Installs all bundles from the bundle libraries at the specified locations.
+         *
+         * This behaves like calling InstallBundles(const std::string&, const AnyMap&) for each
+         * location without an injected manifest, but the bundle libraries are opened and the
+         * manifests of their bundles are parsed in parallel. The new bundles are then added to the
+         * framework in one step, get bundle ids in the order of the locations and
+         * <code>BundleEvent::BUNDLE_INSTALLED</code> events are fired in that same order.
+         *
+         * If installing a bundle from a location which was not installed before fails, none of the
+         * bundles from such locations are installed. Locations which are already installed, or
+         * which appear more than once, are processed afterwards as by
+         * InstallBundles(const std::string&, const AnyMap&).
+         *
+         * @param locations The locations of the bundle libraries to install.
+         * @return The Bundle objects of the installed bundle libraries, in the order of the locations.
+         * @throws std::runtime_error If the BundleContext is no longer valid, or if the installation failed.
+         * @throws std::logic_error If the framework instance is no longer active
+         * @throws std::invalid_argument If a location is not a valid UTF8 string
+         */
+        std::vector<Bundle> InstallBundles(std::vector<std::string> const& locations);
+
       private:
         friend US_Framework_EXPORT BundleContext MakeBundleContext(BundleContextPrivate*);
         friend BundleContext MakeBundleContext(std::shared_ptr<BundleContextPrivate> const&);
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <string_view>
 #include <vector>
 
 namespace cppmicroservices
@@ -298,6 +299,20 @@ namespace cppmicroservices
          */
         uint32_t GetCrc32() const;
 
+        /**
+         * Returns a view of the resource data if it is stored uncompressed in
+         * a memory mapped bundle, without copying it.
+         *
+         * The view points directly into the bundle's mapped resource data and
+         * stays valid as long as this %BundleResource object, or a copy of it,
+         * exists. For compressed resources, directories, or bundles whose
+         * resources are not memory mapped an empty view is returned and the
+         * data must be read through a BundleResourceStream.
+         *
+         * @return A view of the stored resource data, or an empty view.
+         */
+        std::string_view GetStoredData() const;
+
       private:
         BundleResource(std::string const& file, std::shared_ptr<BundleArchive const> const& archive);
 
@@ -315,7 +330,9 @@ namespace cppmicroservices
 
         std::size_t Hash() const;
 
-        std::unique_ptr<void, void (*)(void*)> GetData() const;
+        /// Returns a function which starts reading the resource data chunk
+        /// by chunk, see detail::BundleResourceBuffer::OpenFunction.
+        std::function<std::function<std::size_t(char const*&)>()> OpenData() const;
 
         std::shared_ptr<BundleResourcePrivate> d;
     };
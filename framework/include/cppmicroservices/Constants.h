@@ -199,6 +199,58 @@ namespace cppmicroservices
          */
         US_Framework_EXPORT extern const std::string ACTIVATION_LAZY; // = "lazy";
 
+        /**
+         * Manifest header listing the symbolic names of the bundles which must have
+         * finished starting before the bundle is started by Framework::StartBundles.
+         *
+         * The header value is either a string or an array of strings, like:
+         *
+         * <pre>
+         *       bundle: { start_dependencies: [ "com.mycompany.logging" ] }
+         * </pre>
+         *
+         * Only bundles started by the same Framework::StartBundles call are taken
+         * into account, the header does not cause any other bundle to be started.
+         *
+         * The header value may be retrieved from the \c AnyMap object
+         * returned by the \c Bundle::GetHeaders() method.
+         */
+        US_Framework_EXPORT extern const std::string BUNDLE_STARTDEPENDENCIES; // = "bundle.start_dependencies";
+
+        /**
+         * Manifest header specifying the start level of the bundle.
+         *
+         * The header value is a positive integer and defaults to 1. When the
+         * framework moves to a higher start level, the bundles marked to be
+         * started whose start level lies in between are started, level by level.
+         * Moving to a lower start level stops the bundles above it, again level
+         * by level.
+         *
+         * The header value may be retrieved from the \c AnyMap object
+         * returned by the \c Bundle::GetHeaders() method.
+         *
+         * @see #FRAMEWORK_BEGINNING_STARTLEVEL
+         * @see Framework#SetStartLevel(int)
+         */
+        US_Framework_EXPORT extern const std::string BUNDLE_STARTLEVEL; // = "bundle.start_level";
+
+        /**
+         * Manifest header marking the shared library of the bundle to be loaded
+         * in the background right after the bundle is installed, if the
+         * framework preloads bundles. The header value is a boolean and
+         * defaults to false, in which case the library file is only read ahead.
+         *
+         * <pre>
+         *       bundle: { preload: true }
+         * </pre>
+         *
+         * The header value may be retrieved from the \c AnyMap object
+         * returned by the \c Bundle::GetHeaders() method.
+         *
+         * @see #FRAMEWORK_BUNDLE_PRELOAD
+         */
+        US_Framework_EXPORT extern const std::string BUNDLE_PRELOAD; // = "bundle.preload";
+
         /**
          * Framework environment property identifying the Framework version.
          *
@@ -246,6 +298,109 @@ namespace cppmicroservices
          */
         US_Framework_EXPORT extern const std::string FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT; // = "onFirstInit";
 
+        /**
+         * Framework launching property enabling the persistent bundle cache.
+         * This property's default value is boolean \c false.
+         *
+         * If set to \c true, installed bundles are recorded in the "bundles"
+         * directory of the persistent storage area (see #FRAMEWORK_STORAGE) when
+         * the framework stops, together with their parsed manifests and their
+         * autostart settings. The next framework instance using the same storage
+         * area re-installs these bundles during initialization without parsing
+         * their manifests again and starts the ones tagged to start on launch.
+         * A cached bundle whose file size, modification time or file id (the
+         * inode on POSIX systems) changed is dropped from the cache and has to
+         * be installed again.
+         *
+         * @see #FRAMEWORK_STORAGE_CLEAN
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_BUNDLE_CACHE; // = "org.cppmicroservices.framework.bundle.cache";
+
+        /**
+         * Framework launching property specifying the start level the framework
+         * enters when it is started. This property's default value is the integer 1.
+         * The value may also be given as a string. Values which are not positive
+         * integers are ignored.
+         *
+         * @see #BUNDLE_STARTLEVEL
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_BEGINNING_STARTLEVEL; // = "org.osgi.framework.startlevel.beginning";
+
+        /**
+         * Framework launching property enabling the concurrent activation of the
+         * bundles of one start level. This property's default value is off
+         * (boolean 'false'), which starts the bundles of one level one after the
+         * other in bundle id order.
+         *
+         * If enabled, the bundles of one start level are started concurrently as
+         * by Framework::StartBundles(), taking the #BUNDLE_STARTDEPENDENCIES
+         * manifest headers into account. This applies to launching the framework
+         * and to Framework::SetStartLevel().
+         *
+         * @see #BUNDLE_STARTLEVEL
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_STARTLEVEL_CONCURRENT; // = "org.cppmicroservices.framework.startlevel.concurrent";
+
+        /**
+         * Framework launching property enabling the preloading of installed
+         * bundles. This property's default value is off (boolean 'false').
+         *
+         * If enabled, a background thread reads the shared library of every
+         * installed bundle ahead into the file system cache, and loads the
+         * libraries of bundles with the #BUNDLE_PRELOAD manifest header, so that
+         * starting them does not wait for the library to be loaded. The time
+         * spent loading each library is reported in a FrameworkEvent of type
+         * FRAMEWORK_INFO. If a #FRAMEWORK_BUNDLE_VALIDATION_FUNC is set, the
+         * libraries are only read ahead, because they are validated when the
+         * bundle is started, before they are loaded. The property has no effect
+         * if the framework is built without threading support.
+         *
+         * @see #BUNDLE_PRELOAD
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_BUNDLE_PRELOAD; // = "org.cppmicroservices.framework.bundle.preload";
+
+        /**
+         * Framework launching property specifying the path of a file to write a
+         * start-up timeline to. Not set by default, which disables the timeline.
+         *
+         * If set, the framework records from Framework::Init() on how long
+         * scanning bundle files, parsing manifests, loading bundle libraries,
+         * calling bundle activators, notifying bundle listeners and registering
+         * services took, on which thread and for which bundle. Recording stops
+         * when the framework has started, before the FRAMEWORK_STARTED event
+         * is sent. The timeline is then written in the Chrome trace-event
+         * JSON format, and can be opened in chrome://tracing or Perfetto.
+         * The value must be a \c std::string, other values are ignored.
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_STARTUP_TRACE; // = "org.cppmicroservices.framework.startup.trace";
+
+        /**
+         * Framework launching property enabling the fast shutdown mode. This
+         * property's default value is off (boolean 'false').
+         *
+         * If enabled, stopping the framework stops the bundles of one start level
+         * concurrently, taking the #BUNDLE_STARTDEPENDENCIES manifest headers
+         * into account: a bundle is stopped after the bundles depending on it.
+         * The services of a bundle are removed from the registry in one batch,
+         * and bundle and service events are no longer delivered to listeners of
+         * bundles which are already stopping. The property has no effect on
+         * stopping individual bundles.
+         *
+         * Note that all services of a bundle are removed from the registry
+         * before the first of their ServiceEvent::SERVICE_UNREGISTERING events
+         * is delivered. A listener handling the event for one of these services
+         * cannot look up the others with BundleContext::GetServiceReferences()
+         * any more, even though their own events are still to come. The
+         * services can still be obtained through the references of their events.
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_FAST_SHUTDOWN; // = "org.cppmicroservices.framework.shutdown.fast";
+
         /**
          * The framework's threading support property key name.
          * This property's default value is "single".
@@ -433,6 +588,22 @@ namespace cppmicroservices
          */
         US_Framework_EXPORT extern const std::string SCOPE_PROTOTYPE; // = "prototype"
 
+        /**
+         * Service property enabling pooling of prototype scope service objects.
+         *
+         * If a PooledPrototypeServiceFactory is registered with this property set to
+         * a positive \c int value, service objects released through ServiceObjects are
+         * not handed back to the factory right away. Instead, the framework calls
+         * PooledPrototypeServiceFactory::ResetService and keeps up to this many reset
+         * objects per bundle, reusing them for subsequent ServiceObjects::GetService()
+         * calls of the same bundle. The property is evaluated when the service is
+         * registered and ignored for other service factories.
+         *
+         * @see SCOPE_PROTOTYPE
+         */
+        US_Framework_EXPORT extern const std::string
+            SERVICE_PROTOTYPE_POOL_SIZE; // = "org.cppmicroservices.service.prototype.pool.size"
+
         /**
          * Service property that holds optional flags for dlopen calls on POSIX systems.
          */
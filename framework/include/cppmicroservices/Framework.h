@@ -30,6 +30,7 @@
 #include <map>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace cppmicroservices
 {
@@ -135,6 +136,70 @@ namespace cppmicroservices
          */
         FrameworkEvent WaitForStop(std::chrono::milliseconds const& timeout);
 
+        /**
+         * Start a set of bundles concurrently.
+         *
+         * <p>
+         * Each bundle is started as by Bundle::Start(uint32_t) on a pool of worker
+         * threads, the calling thread being one of them. A bundle is started only
+         * after the bundles of the set named in its
+         * {@link Constants#BUNDLE_STARTDEPENDENCIES bundle.start_dependencies}
+         * manifest header have finished starting, whether they started successfully
+         * or not. Independent bundles are started in parallel. If the framework was
+         * not built with threading support, the bundles are started one after the
+         * other in an order respecting their start dependencies.
+         *
+         * <p>
+         * If starting some bundles fails, the other bundles are still started. This
+         * method returns after all bundles finished starting and then rethrows the
+         * exception of the first failing bundle in the order of \c bundles.
+         *
+         * @param bundles The bundles to start. Bundles already active are left as they are.
+         * @param options The options passed to Bundle::Start(uint32_t) for each bundle.
+         * @throws std::invalid_argument If the start dependencies between the bundles
+         *         are cyclic or a bundle.start_dependencies header is malformed. No
+         *         bundle is started in that case.
+         * @throws std::runtime_error, std::logic_error The exception thrown by the first
+         *         bundle which failed to start.
+         */
+        void StartBundles(std::vector<Bundle> const& bundles, uint32_t options = 0);
+
+        /**
+         * Returns the active start level of this framework.
+         *
+         * @return The active start level, or 0 if this framework is not started.
+         * @see Constants#BUNDLE_STARTLEVEL
+         */
+        int GetStartLevel() const;
+
+        /**
+         * Move this framework to a new start level.
+         *
+         * <p>
+         * The start level is changed asynchronously, this method returns
+         * immediately. When moving to a higher start level, the bundles marked to
+         * be started are started level by level, in bundle id order within one
+         * level, or concurrently as by StartBundles() if the
+         * {@link Constants#FRAMEWORK_STARTLEVEL_CONCURRENT} framework property is
+         * enabled. When moving to a lower start level,
+         * the active bundles above it are stopped level by level, without
+         * changing their autostart setting. A {@link FrameworkEvent#FRAMEWORK_STARTLEVEL_CHANGED
+         * FRAMEWORK_STARTLEVEL_CHANGED} event is fired for each level in which
+         * bundles were started or stopped and once the requested start level is
+         * reached. Failures to start or stop a bundle are reported as
+         * {@link FrameworkEvent#FRAMEWORK_ERROR FRAMEWORK_ERROR} events.
+         *
+         * <p>
+         * If the start level is changed again before a previous change completed,
+         * the framework moves to the most recently requested start level.
+         *
+         * @param startLevel The new start level.
+         * @throws std::invalid_argument If \c startLevel is not positive.
+         * @throws std::logic_error If this framework is not active.
+         * @see Constants#FRAMEWORK_BEGINNING_STARTLEVEL
+         */
+        void SetStartLevel(int startLevel);
+
         /**
          * Start this Framework.
          *
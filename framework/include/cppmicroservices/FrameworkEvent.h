@@ -87,6 +87,18 @@ namespace cppmicroservices
              */
             FRAMEWORK_ERROR = 0x00000002,
 
+            /**
+             * A start level has been reached.
+             *
+             * <p>
+             * This event is fired when the Framework reached a start level in which
+             * bundles were started or stopped, and when it completed a change of its
+             * start level requested by Framework::SetStartLevel(int). The message of
+             * the event names the start level and the time spent to reach it. The
+             * source of this event is the System Bundle.
+             */
+            FRAMEWORK_STARTLEVEL_CHANGED = 0x00000008,
+
             /**
              * A warning has occurred.
              *
@@ -186,6 +198,7 @@ namespace cppmicroservices
          * <ul>
          * <li>{@link #FRAMEWORK_STARTED}
          * <li>{@link #FRAMEWORK_ERROR}
+         * <li>{@link #FRAMEWORK_STARTLEVEL_CHANGED}
          * <li>{@link #FRAMEWORK_WARNING}
          * <li>{@link #FRAMEWORK_INFO}
          * <li>{@link #FRAMEWORK_STOPPED}
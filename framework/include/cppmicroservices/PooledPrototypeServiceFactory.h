@@ -0,0 +1,71 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_POOLEDPROTOTYPESERVICEFACTORY_H
+#define CPPMICROSERVICES_POOLEDPROTOTYPESERVICEFACTORY_H
+
+#include "cppmicroservices/PrototypeServiceFactory.h"
+
+namespace cppmicroservices
+{
+
+    /**
+     * @ingroup MicroServices
+     *
+     * A PrototypeServiceFactory whose service objects can be reused.
+     *
+     * If a PooledPrototypeServiceFactory is registered with the
+     * Constants::SERVICE_PROTOTYPE_POOL_SIZE property, service objects released
+     * through ServiceObjects are not handed back to the factory right away. The
+     * framework calls ResetService and keeps the reset object for a later
+     * ServiceObjects::GetService() call of the same bundle. Other
+     * PrototypeServiceFactory objects are never pooled.
+     *
+     * @see PrototypeServiceFactory
+     * @see Constants::SERVICE_PROTOTYPE_POOL_SIZE
+     */
+    struct PooledPrototypeServiceFactory : public PrototypeServiceFactory
+    {
+
+        /**
+         * Resets a released service object so that it can be reused.
+         *
+         * The framework invokes this method when a caller released a service object
+         * and the pool of the bundle is not full. The reset object is then returned
+         * by a later ServiceObjects::GetService() call of the same bundle instead of
+         * calling GetService. If this method returns <code>false</code> or throws an
+         * exception, the framework calls UngetService with the service object instead
+         * of pooling it.
+         *
+         * @param bundle The bundle releasing the service.
+         * @param registration The ServiceRegistrationBase object for the service being released.
+         * @param service The service object returned by a previous call to the GetService method.
+         * @return <code>true</code> if the service object may be reused.
+         */
+        virtual bool ResetService(Bundle const& bundle,
+                                  ServiceRegistrationBase const& registration,
+                                  InterfaceMapConstPtr const& service)
+            = 0;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_POOLEDPROTOTYPESERVICEFACTORY_H
@@ -89,7 +89,11 @@ namespace cppmicroservices
          * The framework caches the valid service object, and will return the same
          * service object on any future call to \c BundleContext::GetService for the
          * specified bundle. This means the framework does not allow this method to
-         * be concurrently called for the specified bundle.
+         * be concurrently called for the specified bundle. Other threads requesting
+         * the service for the specified bundle while this method runs block until
+         * it returns. This method must therefore not wait for such a request on
+         * another thread: unlike a recursive call on the same thread, the resulting
+         * deadlock is not detected.
          *
          * @param bundle The bundle requesting the service.
          * @param registration The \c ServiceRegistrationBase object for the
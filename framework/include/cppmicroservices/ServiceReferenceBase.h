@@ -120,6 +120,60 @@ namespace cppmicroservices
          */
         std::vector<std::string> GetPropertyKeys() const;
 
+        /**
+         * Returns the \link Constants::SERVICE_ID service id\endlink of the
+         * referenced service.
+         *
+         * <p>
+         * Unlike GetProperty(), this method does not lock the service properties.
+         * It continues to return the id after the service has been unregistered.
+         *
+         * @return The service id, or 0 if this object does not reference a service.
+         */
+        long GetServiceId() const;
+
+        /**
+         * Returns the \link Constants::SERVICE_RANKING service ranking\endlink of
+         * the referenced service, reflecting the latest call to
+         * ServiceRegistrationBase::SetProperties.
+         *
+         * <p>
+         * Unlike GetProperty(), this method does not lock the service properties.
+         *
+         * @return The service ranking, or 0 if the service has no (integer) ranking
+         *         property or this object does not reference a service.
+         */
+        int GetServiceRanking() const;
+
+        /**
+         * Returns the \link Constants::OBJECTCLASS interface ids\endlink under
+         * which the referenced service was registered.
+         *
+         * <p>
+         * Unlike GetProperty(), this method does not lock the service properties.
+         * The returned vector is valid as long as this object references the
+         * same service.
+         *
+         * @return The interface ids, or an empty vector if this object does not
+         *         reference a service.
+         */
+        std::vector<std::string> const& GetObjectClasses() const;
+
+        /**
+         * Returns the \link Constants::SERVICE_SCOPE scope\endlink of the
+         * referenced service.
+         *
+         * <p>
+         * Unlike GetProperty(), this method does not lock the service properties.
+         * The returned string is valid as long as this object references the
+         * same service.
+         *
+         * @return One of Constants::SCOPE_SINGLETON, Constants::SCOPE_BUNDLE or
+         *         Constants::SCOPE_PROTOTYPE, or an empty string if this object does
+         *         not reference a service.
+         */
+        std::string const& GetServiceScope() const;
+
         /**
          * Returns the bundle that registered the service referenced by this
          * <code>ServiceReferenceBase</code> object.
@@ -279,7 +279,9 @@ namespace cppmicroservices
 
         /**
          * Return a list of <code>ServiceReference</code>s for all services being
-         * tracked by this <code>ServiceTracker</code>.
+         * tracked by this <code>ServiceTracker</code>. The list is ordered by
+         * descending service ranking, and ascending service id for services with
+         * the same ranking.
          *
          * @return A list of <code>ServiceReference</code> objects.
          */
@@ -323,10 +325,8 @@ namespace cppmicroservices
          * <code>ServiceTracker</code>.
          *
          * <p>
-         * This implementation calls GetServiceReferences() to get the list
-         * of references for the tracked services and then calls
-         * GetService(const ServiceReference&) for each reference to get the
-         * tracked service object.
+         * The service objects are in the same order as the references returned
+         * by GetServiceReferences().
          *
          * @return A list of service objects or an empty list if no services
          *         are being tracked.
@@ -28,7 +28,9 @@
 #include "cppmicroservices/detail/WaitCondition.h"
 
 #include <atomic>
+#include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace cppmicroservices
@@ -59,6 +61,7 @@ namespace cppmicroservices
 
           public:
             using TrackingMap = std::unordered_map<S, T>;
+            using Snapshot = std::vector<std::pair<S, T>>;
 
             /**
              * BundleAbstractTracked constructor.
@@ -178,6 +181,26 @@ namespace cppmicroservices
              */
             void CopyEntries_unlocked(TrackingMap& map) const;
 
+            /**
+             * Return an immutable snapshot of the tracked items and associated values,
+             * in the order established by OrderSnapshot_unlocked(). The snapshot is
+             * only rebuilt if the tracking count changed since it was last built, so
+             * repeated calls return the same shared snapshot.
+             *
+             * @return The current snapshot of the tracked items.
+             * @GuardedBy this
+             */
+            std::shared_ptr<Snapshot const> GetSnapshot_unlocked() const;
+
+            /**
+             * Order a newly built snapshot of the tracked items. The default
+             * implementation keeps the iteration order of the tracked items.
+             *
+             * @param snapshot The snapshot to order.
+             * @GuardedBy this
+             */
+            virtual void OrderSnapshot_unlocked(Snapshot& snapshot) const;
+
             /**
              * Call the specific customizer adding method. This method must not be
              * called while synchronized on this object.
@@ -209,6 +232,34 @@ namespace cppmicroservices
              */
             virtual void CustomizerRemoved(S item, R const& related, T const& object) = 0;
 
+            /**
+             * Called after an item was added to the tracked items. The default
+             * implementation does nothing.
+             *
+             * @param item The tracked item.
+             * @param object Customized object for the tracked item.
+             * @GuardedBy this
+             */
+            virtual void ItemAdded_unlocked(S const& item, T const& object);
+
+            /**
+             * Called when a tracked item was modified. The default implementation
+             * does nothing.
+             *
+             * @param item The tracked item.
+             * @GuardedBy this
+             */
+            virtual void ItemModified_unlocked(S const& item);
+
+            /**
+             * Called after an item was removed from the tracked items. The default
+             * implementation does nothing.
+             *
+             * @param item The untracked item.
+             * @GuardedBy this
+             */
+            virtual void ItemRemoved_unlocked(S const& item);
+
             /**
              * List of items in the process of being added. This is used to deal with
              * nesting of events. Since events may be synchronously delivered, events
@@ -275,6 +326,16 @@ namespace cppmicroservices
              */
             std::atomic<int> trackingCount;
 
+            /**
+             * Cached result of GetSnapshot_unlocked() and the tracking count it was
+             * built for. Dropped whenever the tracked items change or the tracker
+             * is closed, so that it does not keep untracked objects alive.
+             *
+             * @GuardedBy this
+             */
+            mutable std::shared_ptr<Snapshot const> snapshot;
+            mutable int snapshotTrackingCount;
+
             BundleContext bc;
 
             bool CustomizerAddingFinal(S item, std::optional<T> const& custom);
@@ -35,6 +35,7 @@ namespace cppmicroservices
         BundleAbstractTracked<S, T, R>::BundleAbstractTracked(BundleContext context)
             : closed(false)
             , trackingCount(0)
+            , snapshotTrackingCount(-1)
             , bc(std::move(context))
         {
         }
@@ -99,7 +100,10 @@ namespace cppmicroservices
         void
         BundleAbstractTracked<S, T, R>::Close()
         {
+            auto l = this->Lock();
+            US_UNUSED(l);
             closed = true;
+            snapshot.reset();
         }
 
         template <class S, class T, class R>
@@ -131,7 +135,8 @@ namespace cppmicroservices
                     adding.push_back(item); /* mark this item is being added */
                 }
                 else
-                {               /* we are currently tracking this item */
+                { /* we are currently tracking this item */
+                    ItemModified_unlocked(item);
                     Modified(); /* increment modification count */
                 }
             }
@@ -193,6 +198,8 @@ namespace cppmicroservices
                  */
                 object = trackedItemIter->second;
                 tracked.erase(item);
+                snapshot.reset(); /* release the cached reference to object */
+                ItemRemoved_unlocked(item);
                 Modified(); /* increment modification count */
             }
             /* Call customizer outside of synchronized region */
@@ -246,6 +253,25 @@ namespace cppmicroservices
         {
             // atomic
             ++trackingCount;
+            snapshot.reset();
+        }
+
+        template <class S, class T, class R>
+        void
+        BundleAbstractTracked<S, T, R>::ItemAdded_unlocked(S const& /*item*/, T const& /*object*/)
+        {
+        }
+
+        template <class S, class T, class R>
+        void
+        BundleAbstractTracked<S, T, R>::ItemModified_unlocked(S const& /*item*/)
+        {
+        }
+
+        template <class S, class T, class R>
+        void
+        BundleAbstractTracked<S, T, R>::ItemRemoved_unlocked(S const& /*item*/)
+        {
         }
 
         template <class S, class T, class R>
@@ -263,6 +289,27 @@ namespace cppmicroservices
             map.insert(tracked.begin(), tracked.end());
         }
 
+        template <class S, class T, class R>
+        std::shared_ptr<typename BundleAbstractTracked<S, T, R>::Snapshot const>
+        BundleAbstractTracked<S, T, R>::GetSnapshot_unlocked() const
+        {
+            int const count = trackingCount;
+            if (!snapshot || snapshotTrackingCount != count)
+            {
+                auto newSnapshot = std::make_shared<Snapshot>(tracked.begin(), tracked.end());
+                OrderSnapshot_unlocked(*newSnapshot);
+                snapshot = std::move(newSnapshot);
+                snapshotTrackingCount = count;
+            }
+            return snapshot;
+        }
+
+        template <class S, class T, class R>
+        void
+        BundleAbstractTracked<S, T, R>::OrderSnapshot_unlocked(Snapshot& /*snapshot*/) const
+        {
+        }
+
         template <class S, class T, class R>
         bool
         BundleAbstractTracked<S, T, R>::CustomizerAddingFinal(S item, std::optional<T> const& custom)
@@ -280,6 +327,7 @@ namespace cppmicroservices
                 if (custom)
                 {
                     tracked[item] = custom.value();
+                    ItemAdded_unlocked(item, custom.value());
                     Modified();        /* increment modification count */
                     this->NotifyAll(); /* notify any waiters */
                 }
@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/FrameworkExport.h"
 
+#include <functional>
 #include <memory>
 #include <streambuf>
 
@@ -40,6 +41,15 @@ namespace cppmicroservices
         {
 
           public:
+            /// Makes the next chunk of data available in \c chunk and returns
+            /// its size, or 0 if there is no more data. The chunk stays valid
+            /// until the next call. Read errors are thrown, which sets badbit
+            /// on the reading stream.
+            using ReadFunction = std::function<std::size_t(char const*& chunk)>;
+
+            /// Returns a ReadFunction which starts at the beginning of the data.
+            using OpenFunction = std::function<ReadFunction()>;
+
             BundleResourceBuffer(BundleResourceBuffer const&) = delete;
             BundleResourceBuffer& operator=(BundleResourceBuffer const&) = delete;
 
@@ -47,6 +57,10 @@ namespace cppmicroservices
                                           std::size_t size,
                                           std::ios_base::openmode mode);
 
+            /// Reads \c size bytes of data in chunks, so that only the
+            /// current chunk needs to be kept in memory.
+            explicit BundleResourceBuffer(OpenFunction open, std::size_t size, std::ios_base::openmode mode);
+
             ~BundleResourceBuffer() override;
 
           private:
@@ -28,7 +28,6 @@
 #include "cppmicroservices/detail/TrackedService.h"
 
 #include <chrono>
-#include <limits>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -310,10 +309,11 @@ namespace cppmicroservices
         { /* if ServiceTracker is not open */
             return refs;
         }
+        auto snapshot = (t->Lock(), t->GetSnapshot_unlocked());
+        refs.reserve(snapshot->size());
+        for (auto const& entry : *snapshot)
         {
-            auto l = t->Lock();
-            US_UNUSED(l);
-            d->GetServiceReferences_unlocked(refs, t.get());
+            refs.push_back(entry.first);
         }
         return refs;
     }
@@ -322,76 +322,12 @@ namespace cppmicroservices
     ServiceReference<S>
     ServiceTracker<S, T>::GetServiceReference() const
     {
-        ServiceReference<S> reference = d->cachedReference.Load();
-        if (reference.GetBundle())
-        {
-            return reference;
-        }
-        auto references = GetServiceReferences();
-        std::size_t length = references.size();
-        if (length == 0)
+        auto highestRanked = d->highestRanked.Load();
+        if (!highestRanked)
         { /* if no service is being tracked */
             throw ServiceException("No service is being tracked");
         }
-        auto selectedRef = references.begin();
-        if (length > 1)
-        { /* if more than one service, select highest ranking */
-            std::vector<int> rankings(length);
-            int count = 0;
-            int maxRanking = (std::numeric_limits<int>::min)();
-            auto refIter = references.begin();
-            for (std::size_t i = 0; i < length; i++)
-            {
-                Any rankingAny = refIter->GetProperty(Constants::SERVICE_RANKING);
-                int ranking = 0;
-                if (rankingAny.Type() == typeid(int))
-                {
-                    ranking = any_cast<int>(rankingAny);
-                }
-
-                rankings[i] = ranking;
-                if (ranking > maxRanking)
-                {
-                    selectedRef = refIter;
-                    maxRanking = ranking;
-                    count = 1;
-                }
-                else
-                {
-                    if (ranking == maxRanking)
-                    {
-                        count++;
-                    }
-                }
-                ++refIter;
-            }
-            if (count > 1)
-            { /* if still more than one service, select lowest id */
-                long int minId = (std::numeric_limits<long int>::max)();
-                refIter = references.begin();
-                for (std::size_t i = 0; i < length; i++)
-                {
-                    if (rankings[i] == maxRanking)
-                    {
-                        Any idAny = refIter->GetProperty(Constants::SERVICE_ID);
-                        long int id = 0;
-                        if (idAny.Type() == typeid(long int))
-                        {
-                            id = any_cast<long int>(idAny);
-                        }
-                        if (id < minId)
-                        {
-                            selectedRef = refIter;
-                            minId = id;
-                        }
-                    }
-                    ++refIter;
-                }
-            }
-        }
-
-        d->cachedReference.Store(*selectedRef);
-        return *selectedRef;
+        return highestRanked->reference;
     }
 
     template <class S, class T>
@@ -419,15 +355,11 @@ namespace cppmicroservices
         { /* if ServiceTracker is not open */
             return services;
         }
+        auto snapshot = (t->Lock(), t->GetSnapshot_unlocked());
+        services.reserve(snapshot->size());
+        for (auto const& entry : *snapshot)
         {
-            auto l = t->Lock();
-            US_UNUSED(l);
-            std::vector<ServiceReference<S>> references;
-            d->GetServiceReferences_unlocked(references, t.get());
-            for (auto& ref : references)
-            {
-                services.push_back(t->GetCustomizedObject_unlocked(ref).value_or(nullptr));
-            }
+            services.push_back(entry.second);
         }
         return services;
     }
@@ -436,27 +368,12 @@ namespace cppmicroservices
     std::shared_ptr<typename ServiceTracker<S, T>::TrackedParamType>
     ServiceTracker<S, T>::GetService() const
     {
-        auto service = d->cachedService.Load();
-        if (service)
-        {
-            return service;
-        }
-
-        try
-        {
-            auto reference = GetServiceReference();
-            if (!reference.GetBundle())
-            {
-                return std::shared_ptr<TrackedParamType>();
-            }
-            service = GetService(reference);
-            d->cachedService.Store(service);
-            return service;
-        }
-        catch (ServiceException const&)
+        auto highestRanked = d->highestRanked.Load();
+        if (!highestRanked)
         {
             return std::shared_ptr<TrackedParamType>();
         }
+        return highestRanked->service;
     }
 
     template <class S, class T>
@@ -512,7 +429,8 @@ namespace cppmicroservices
         { /* if ServiceTracker is not open */
             return;
         }
-        t->Lock(), t->CopyEntries_unlocked(map);
+        auto snapshot = (t->Lock(), t->GetSnapshot_unlocked());
+        map.insert(snapshot->begin(), snapshot->end());
     }
 
     template <class S, class T>
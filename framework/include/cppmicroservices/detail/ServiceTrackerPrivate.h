@@ -77,8 +77,6 @@ namespace cppmicroservices
             std::vector<ServiceReference<S>> GetInitialReferences(std::string const& className,
                                                                   std::string const& filterString);
 
-            void GetServiceReferences_unlocked(std::vector<ServiceReference<S>>& refs, TrackedService<S, TTT>* t) const;
-
             /**
              * The Bundle Context used by this <code>ServiceTracker</code>.
              */
@@ -136,8 +134,7 @@ namespace cppmicroservices
             std::shared_ptr<TrackedService<S, TTT>> Tracked() const;
 
             /**
-             * Called by the TrackedService object whenever the set of tracked services is
-             * modified. Clears the cache.
+             * Clears the highest ranked service. Called when the tracker is closed.
              */
             /*
              * This method must not be synchronized since it is called by TrackedService while
@@ -147,14 +144,30 @@ namespace cppmicroservices
             void Modified();
 
             /**
-             * Cached ServiceReference for getServiceReference.
+             * A tracked <code>ServiceReference</code> and its customized service object.
              */
-            mutable Atomic<ServiceReference<S>> cachedReference;
+            struct RankedService
+            {
+                ServiceReference<S> reference;
+                std::shared_ptr<TrackedParamType> service;
+            };
 
             /**
-             * Cached service object for GetService.
+             * The highest ranked tracked service, used by GetServiceReference and
+             * GetService. It is kept up to date by the TrackedService object as
+             * services are added, modified and removed, and is empty if no service
+             * is tracked.
+             *
+             * Reads go through the std::atomic_load() overloads for std::shared_ptr.
+             * These are not lock-free on common standard libraries: libstdc++, for
+             * example, guards them with a small global pool of spin locks. A read is
+             * therefore a short critical section which does not depend on the
+             * tracker's own lock, but it is not wait-free.
+             * std::atomic<std::shared_ptr> is not used because it would make the
+             * layout of Atomic<std::shared_ptr<T>> depend on the language standard
+             * of the including code.
              */
-            mutable Atomic<std::shared_ptr<TrackedParamType>> cachedService;
+            mutable Atomic<std::shared_ptr<RankedService const>> highestRanked;
 
           private:
             inline ServiceTracker<S, T>*
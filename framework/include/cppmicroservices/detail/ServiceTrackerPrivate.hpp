@@ -45,14 +45,12 @@ namespace cppmicroservices
             , listenerToken()
             , trackReference(reference)
             , trackedService()
-            , cachedReference()
-            , cachedService()
+            , highestRanked()
             , q_ptr(st)
         {
             this->customizer = customizer ? customizer : q_func();
             std::stringstream ss;
-            ss << "(" << Constants::SERVICE_ID << "=" << any_cast<long>(reference.GetProperty(Constants::SERVICE_ID))
-               << ")";
+            ss << "(" << Constants::SERVICE_ID << "=" << reference.GetServiceId() << ")";
             this->listenerFilter = ss.str();
             try
             {
@@ -80,8 +78,7 @@ namespace cppmicroservices
             , trackClass(clazz)
             , trackReference()
             , trackedService()
-            , cachedReference()
-            , cachedService()
+            , highestRanked()
             , q_ptr(st)
         {
             this->customizer = customizer ? customizer : q_func();
@@ -113,8 +110,7 @@ namespace cppmicroservices
             , listenerToken()
             , trackReference()
             , trackedService()
-            , cachedReference()
-            , cachedService()
+            , highestRanked()
             , q_ptr(st)
         {
             this->customizer = customizer ? customizer : q_func();
@@ -145,18 +141,6 @@ namespace cppmicroservices
             return result;
         }
 
-        template <class S, class TTT>
-        void
-        ServiceTrackerPrivate<S, TTT>::GetServiceReferences_unlocked(std::vector<ServiceReference<S>>& refs,
-                                                                     detail::TrackedService<S, TTT>* t) const
-        {
-            if (t->Size_unlocked() == 0)
-            {
-                return;
-            }
-            t->GetTracked_unlocked(refs);
-        }
-
         template <class S, class TTT>
         std::shared_ptr<detail::TrackedService<S, TTT>>
         ServiceTrackerPrivate<S, TTT>::Tracked() const
@@ -168,8 +152,7 @@ namespace cppmicroservices
         void
         ServiceTrackerPrivate<S, TTT>::Modified()
         {
-            cachedReference.Store(ServiceReference<S>());             /* clear cached value */
-            cachedService.Store(std::shared_ptr<TrackedParamType>()); /* clear cached value */
+            highestRanked.Store(nullptr);
         }
 
     } // namespace detail
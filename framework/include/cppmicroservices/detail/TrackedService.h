@@ -23,6 +23,7 @@
 #ifndef CPPMICROSERVICES_TRACKEDSERVICE_H
 #define CPPMICROSERVICES_TRACKEDSERVICE_H
 
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/ServiceEvent.h"
 #include "cppmicroservices/detail/BundleAbstractTracked.h"
 #include "cppmicroservices/detail/TrackedServiceListener.h"
@@ -30,7 +31,11 @@
 #include "cppmicroservices/detail/CounterLatch.h"
 #include "cppmicroservices/detail/ScopeGuard.h"
 
+#include <algorithm>
+#include <iterator>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace cppmicroservices
 {
@@ -78,12 +83,57 @@ namespace cppmicroservices
             CounterLatch latch;
 
             /**
-             * Increment the tracking count and tell the tracker there was a
-             * modification.
+             * Publish <code>item</code> as the highest ranked service if it ranks
+             * higher than the current one.
              *
              * @GuardedBy this
              */
-            void Modified() override;
+            void ItemAdded_unlocked(ServiceReference<S> const& item,
+                                    std::shared_ptr<TrackedParamType> const& object) override;
+
+            /**
+             * Re-select the highest ranked service, since the ranking of
+             * <code>item</code> may have changed.
+             *
+             * @GuardedBy this
+             */
+            void ItemModified_unlocked(ServiceReference<S> const& item) override;
+
+            /**
+             * Re-select the highest ranked service if <code>item</code> was the
+             * highest ranked one.
+             *
+             * @GuardedBy this
+             */
+            void ItemRemoved_unlocked(ServiceReference<S> const& item) override;
+
+            /**
+             * Select the highest ranked service from all tracked services and
+             * publish it to the tracker.
+             *
+             * @GuardedBy this
+             */
+            void SelectHighestRanked_unlocked();
+
+            /**
+             * Order the snapshot of tracked services by descending ranking, and
+             * ascending service id for services of the same ranking.
+             *
+             * @GuardedBy this
+             */
+            void OrderSnapshot_unlocked(typename Superclass::Snapshot& snapshot) const override;
+
+            /**
+             * Returns the service ranking and the negated service id of
+             * <code>ref</code>. A higher key denotes a higher ranked service.
+             */
+            static std::pair<int, long int> RankingKey(ServiceReference<S> const& ref);
+
+            /**
+             * Returns <code>true</code> if <code>a</code> has a higher ranking than
+             * <code>b</code>, or the same ranking and a lower service id.
+             */
+            static bool RanksHigher(ServiceReference<S> const& a, ServiceReference<S> const& b);
 
             /**
              * Call the specific customizer adding method. This method must not be
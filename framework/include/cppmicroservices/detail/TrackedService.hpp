@@ -130,10 +130,103 @@ namespace cppmicroservices
 
         template <class S, class TTT>
         void
-        TrackedService<S, TTT>::Modified()
+        TrackedService<S, TTT>::ItemAdded_unlocked(ServiceReference<S> const& item,
+                                                   std::shared_ptr<TrackedParamType> const& object)
+        {
+            auto current = serviceTracker->d->highestRanked.Load();
+            if (!current || RanksHigher(item, current->reference))
+            {
+                using RankedService = typename ServiceTrackerPrivate<S, TTT>::RankedService;
+                serviceTracker->d->highestRanked.Store(
+                    std::make_shared<RankedService const>(RankedService { item, object }));
+            }
+        }
+
+        template <class S, class TTT>
+        void
+        TrackedService<S, TTT>::ItemModified_unlocked(ServiceReference<S> const& /*item*/)
+        {
+            SelectHighestRanked_unlocked();
+        }
+
+        template <class S, class TTT>
+        void
+        TrackedService<S, TTT>::ItemRemoved_unlocked(ServiceReference<S> const& item)
+        {
+            auto current = serviceTracker->d->highestRanked.Load();
+            if (this->closed)
+            {
+                serviceTracker->d->highestRanked.Store(nullptr);
+            }
+            else if (!current || current->reference == item)
+            {
+                SelectHighestRanked_unlocked();
+            }
+        }
+
+        template <class S, class TTT>
+        void
+        TrackedService<S, TTT>::SelectHighestRanked_unlocked()
+        {
+            std::vector<ServiceReference<S>> references;
+            this->GetTracked_unlocked(references);
+            if (this->closed || references.empty())
+            {
+                serviceTracker->d->highestRanked.Store(nullptr);
+                return;
+            }
+
+            auto selectedRef = references.begin();
+            for (auto refIter = std::next(selectedRef); refIter != references.end(); ++refIter)
+            {
+                if (RanksHigher(*refIter, *selectedRef))
+                {
+                    selectedRef = refIter;
+                }
+            }
+
+            using RankedService = typename ServiceTrackerPrivate<S, TTT>::RankedService;
+            auto service = this->GetCustomizedObject_unlocked(*selectedRef).value_or(nullptr);
+            serviceTracker->d->highestRanked.Store(
+                std::make_shared<RankedService const>(RankedService { *selectedRef, std::move(service) }));
+        }
+
+        template <class S, class TTT>
+        void
+        TrackedService<S, TTT>::OrderSnapshot_unlocked(typename Superclass::Snapshot& snapshot) const
+        {
+            // look up the ranking properties once per service, not once per comparison
+            std::vector<std::pair<std::pair<int, long int>, std::size_t>> keys;
+            keys.reserve(snapshot.size());
+            for (std::size_t i = 0; i < snapshot.size(); ++i)
+            {
+                keys.emplace_back(RankingKey(snapshot[i].first), i);
+            }
+            std::sort(keys.begin(),
+                      keys.end(),
+                      [](auto const& a, auto const& b) { return a.first > b.first; });
+
+            typename Superclass::Snapshot ordered;
+            ordered.reserve(snapshot.size());
+            for (auto const& key : keys)
+            {
+                ordered.push_back(std::move(snapshot[key.second]));
+            }
+            snapshot.swap(ordered);
+        }
+
+        template <class S, class TTT>
+        std::pair<int, long int>
+        TrackedService<S, TTT>::RankingKey(ServiceReference<S> const& ref)
+        {
+            return { ref.GetServiceRanking(), -ref.GetServiceId() };
+        }
+
+        template <class S, class TTT>
+        bool
+        TrackedService<S, TTT>::RanksHigher(ServiceReference<S> const& a, ServiceReference<S> const& b)
         {
-            Superclass::Modified(); /* increment the modification count */
-            serviceTracker->d->Modified();
+            return RankingKey(a) > RankingKey(b);
         }
 
         template <class S, class TTT>
@@ -185,4 +185,10 @@ namespace cppmicroservices
         return manifest;
     }
 
+    void
+    BundleArchive::SetManifest(AnyMap const& bundleManifest)
+    {
+        manifest = bundleManifest;
+    }
+
 } // namespace cppmicroservices
@@ -157,6 +157,12 @@ namespace cppmicroservices
          */
         AnyMap const& GetInjectedManifest() const;
 
+        /**
+         * Store the manifest read from the bundle file in this bundlearchive, so
+         * that a persistent storage can record it.
+         */
+        void SetManifest(AnyMap const& bundleManifest);
+
       private:
         BundleStorage* const storage;
         const std::shared_ptr<BundleResourceContainer> resourceContainer;
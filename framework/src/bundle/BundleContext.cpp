@@ -197,6 +197,20 @@ namespace cppmicroservices
         return b->coreCtx->services.RegisterService(b.get(), service, properties);
     }
 
+    ServiceRegistrationU
+    BundleContext::RegisterService(InterfaceMapConstPtr const& service, ServiceProperties&& properties)
+    {
+        if (!d)
+        {
+            throw std::runtime_error("The bundle context is no longer valid");
+        }
+
+        d->CheckValid();
+        auto b = GetAndCheckBundlePrivate(d);
+
+        return b->coreCtx->services.RegisterService(b.get(), service, std::move(properties));
+    }
+
     std::vector<ServiceReferenceU>
     BundleContext::GetServiceReferences(std::string const& clazz, std::string const& filter)
     {
@@ -290,8 +304,7 @@ namespace cppmicroservices
         d->CheckValid();
         auto b = GetAndCheckBundlePrivate(d);
 
-        std::shared_ptr<ServiceHolder<void>> h(
-            new ServiceHolder<void>(b, reference, reference.d.Load()->GetService(b.get())));
+        auto h = std::make_shared<ServiceHolder<void>>(b, reference, reference.d.Load()->GetService(b.get()));
         return std::shared_ptr<void>(h, h->service.get());
     }
 
@@ -313,8 +326,7 @@ namespace cppmicroservices
         auto b = GetAndCheckBundlePrivate(d);
 
         auto serviceInterfaceMap = reference.d.Load()->GetServiceInterfaceMap(b.get());
-        std::shared_ptr<ServiceHolder<InterfaceMap const>> h(
-            new ServiceHolder<InterfaceMap const>(b, reference, serviceInterfaceMap));
+        auto h = std::make_shared<ServiceHolder<InterfaceMap const>>(b, reference, serviceInterfaceMap);
         return InterfaceMapConstPtr(h, h->service.get());
     }
 
@@ -509,4 +521,18 @@ namespace cppmicroservices
         return b->coreCtx->bundleRegistry->Install(location, b.get(), bundleManifest);
     }
 
+    std::vector<Bundle>
+    BundleContext::InstallBundles(std::vector<std::string> const& locations)
+    {
+        if (!d)
+        {
+            throw std::runtime_error("The bundle context is no longer valid");
+        }
+
+        d->CheckValid();
+        auto b = GetAndCheckBundlePrivate(d);
+
+        return b->coreCtx->bundleRegistry->Install(locations, b.get());
+    }
+
 } // namespace cppmicroservices
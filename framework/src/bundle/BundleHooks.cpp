@@ -46,9 +46,7 @@ namespace cppmicroservices
             return bundle;
         }
 
-        std::vector<ServiceRegistrationBase> srl;
-        coreCtx->services.Get(us_service_interface_iid<BundleFindHook>(), srl);
-        if (srl.empty())
+        if (!coreCtx->services.HasHooks() || !coreCtx->services.GetHooks(us_service_interface_iid<BundleFindHook>()))
         {
             return bundle;
         }
@@ -64,15 +62,23 @@ namespace cppmicroservices
     void
     BundleHooks::FilterBundles(BundleContext const& context, std::vector<Bundle>& bundles) const
     {
-        std::vector<ServiceRegistrationBase> srl;
-        coreCtx->services.Get(us_service_interface_iid<BundleFindHook>(), srl);
+        if (!coreCtx->services.HasHooks())
+        {
+            return;
+        }
+
+        auto srl = coreCtx->services.GetHooks(us_service_interface_iid<BundleFindHook>());
+        if (!srl)
+        {
+            return;
+        }
+
         ShrinkableVector<Bundle> filtered(bundles);
 
         auto selfBundle = GetBundleContext().GetBundle();
-        std::sort(srl.begin(), srl.end());
-        for (auto srBaseIter = srl.rbegin(), srBaseEnd = srl.rend(); srBaseIter != srBaseEnd; ++srBaseIter)
+        for (auto const& srBase : *srl)
         {
-            ServiceReference<BundleFindHook> sr = srBaseIter->GetReference();
+            ServiceReference<BundleFindHook> sr = srBase.GetReference();
             std::shared_ptr<BundleFindHook> fh
                 = std::static_pointer_cast<BundleFindHook>(sr.d.Load()->GetService(GetPrivate(selfBundle).get()));
             if (fh)
@@ -98,8 +104,11 @@ namespace cppmicroservices
     BundleHooks::FilterBundleEventReceivers(BundleEvent const& evt,
                                             ServiceListeners::BundleListenerMap& bundleListeners)
     {
-        std::vector<ServiceRegistrationBase> eventHooks;
-        coreCtx->services.Get(us_service_interface_iid<BundleEventHook>(), eventHooks);
+        std::shared_ptr<ServiceRegistry::ServiceRegistrations const> eventHooks;
+        if (coreCtx->services.HasHooks())
+        {
+            eventHooks = coreCtx->services.GetHooks(us_service_interface_iid<BundleEventHook>());
+        }
 
         {
             auto l = coreCtx->listeners.bundleListenerMap.Lock();
@@ -107,7 +116,7 @@ namespace cppmicroservices
             bundleListeners = coreCtx->listeners.bundleListenerMap.value;
         }
 
-        if (!eventHooks.empty())
+        if (eventHooks)
         {
             std::vector<BundleContext> bundleContexts;
             for (auto& le : bundleListeners)
@@ -120,13 +129,12 @@ namespace cppmicroservices
             const std::size_t unfilteredSize = bundleContexts.size();
             ShrinkableVector<BundleContext> filtered(bundleContexts);
 
-            std::sort(eventHooks.begin(), eventHooks.end());
-            for (auto iter = eventHooks.rbegin(), iterEnd = eventHooks.rend(); iter != iterEnd; ++iter)
+            for (auto const& eventHook : *eventHooks)
             {
                 ServiceReference<BundleEventHook> sr;
                 try
                 {
-                    sr = iter->GetReference();
+                    sr = eventHook.GetReference();
                 }
                 catch (std::logic_error const&)
                 {
@@ -24,8 +24,10 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
-#include <rapidjson/istreamwrapper.h>
 
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -68,10 +70,38 @@ namespace cppmicroservices
     namespace
     {
 
-        void ParseJsonObject(rapidjson::Value const& jsonObject, AnyMap& anyMap);
+        /**
+         * Size of the stack buffer the JSON document allocator starts with. Nearly all
+         * manifest.json files fit into this, so the DOM built by RapidJSON is carved out of
+         * a single arena which is released in one step when parsing is done.
+         */
+        constexpr std::size_t ParseArenaSize = 16 * 1024;
+
+        using ArenaAllocator = rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>;
+        using ArenaDocument = rapidjson::GenericDocument<rapidjson::UTF8<>, ArenaAllocator, rapidjson::CrtAllocator>;
+
+        void ParseJsonObject(rapidjson::Value const& jsonObject, AnyMap::unordered_any_cimap& anyMap);
         void ParseJsonObject(rapidjson::Value const& jsonObject, AnyOrderedMap& anyMap);
         void ParseJsonArray(rapidjson::Value const& jsonArray, AnyVector& anyVector, bool ci);
 
+        /**
+         * Wrap a parsed object into an Any. The map is moved into place, whereas the
+         * converting Any constructor would copy it along with all nested values.
+         */
+        Any
+        MakeAnyMap(AnyMap::unordered_any_cimap&& map)
+        {
+            Any any = AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            ref_any_cast<AnyMap>(any) = AnyMap(std::move(map));
+            return any;
+        }
+
+        std::string
+        ToString(rapidjson::Value const& jsonString)
+        {
+            return std::string(jsonString.GetString(), jsonString.GetStringLength());
+        }
+
         Any
         ParseJsonValue(rapidjson::Value const& jsonValue, bool ci)
         {
@@ -79,9 +109,11 @@ namespace cppmicroservices
             {
                 if (ci)
                 {
-                    Any any = AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
-                    ParseJsonObject(jsonValue, ref_any_cast<AnyMap>(any));
-                    return any;
+                    // Build the hash map with its final bucket count before handing it
+                    // over to the AnyMap, so inserting the members never re-hashes.
+                    AnyMap::unordered_any_cimap map;
+                    ParseJsonObject(jsonValue, map);
+                    return MakeAnyMap(std::move(map));
                 }
                 else
                 {
@@ -100,11 +132,14 @@ namespace cppmicroservices
             {
                 // We do not support attribute localization yet, so we just
                 // always remove the leading '%' character.
-                std::string val = jsonValue.GetString();
-                if (!val.empty() && val[0] == '%')
-                    val = val.substr(1);
+                char const* val = jsonValue.GetString();
+                auto len = jsonValue.GetStringLength();
+                if (len > 0 && val[0] == '%')
+                {
+                    return Any(std::string(val + 1, len - 1));
+                }
 
-                return Any(val);
+                return Any(std::string(val, len));
             }
             else if (jsonValue.IsBool())
             {
@@ -130,20 +165,21 @@ namespace cppmicroservices
                 Any anyValue = ParseJsonValue(m.value, false);
                 if (!anyValue.Empty())
                 {
-                    anyMap.emplace(m.name.GetString(), std::move(anyValue));
+                    anyMap.emplace(ToString(m.name), std::move(anyValue));
                 }
             }
         }
 
         void
-        ParseJsonObject(rapidjson::Value const& jsonObject, AnyMap& anyMap)
+        ParseJsonObject(rapidjson::Value const& jsonObject, AnyMap::unordered_any_cimap& anyMap)
         {
+            anyMap.reserve(anyMap.size() + jsonObject.MemberCount());
             for (auto const& m : jsonObject.GetObject())
             {
                 Any anyValue = ParseJsonValue(m.value, true);
                 if (!anyValue.Empty())
                 {
-                    anyMap.emplace(m.name.GetString(), std::move(anyValue));
+                    anyMap.emplace(ToString(m.name), std::move(anyValue));
                 }
             }
         }
@@ -151,6 +187,7 @@ namespace cppmicroservices
         void
         ParseJsonArray(rapidjson::Value const& jsonArray, AnyVector& anyVector, bool ci)
         {
+            anyVector.reserve(jsonArray.Size());
             for (auto const& jsonValue : jsonArray.GetArray())
             {
                 Any anyValue = ParseJsonValue(jsonValue, ci);
@@ -161,6 +198,174 @@ namespace cppmicroservices
             }
         }
 
+        /**
+         * Reader for the binary manifest format written by usResourceCompiler.
+         *
+         * The data starts with the signature "USBM" and a format version byte,
+         * followed by the root object. Each value is a one byte tag and its payload:
+         *
+         *   BinaryFalse, BinaryTrue  no payload
+         *   BinaryInt                32 bit two's complement integer, little endian
+         *   BinaryDouble             64 bit IEEE 754 double, little endian
+         *   BinaryString             length, then the UTF-8 bytes
+         *   BinaryArray              element count, then the elements
+         *   BinaryObject             member count, then for each member the key
+         *                            length, the key bytes and the member value
+         *
+         * Lengths and counts are unsigned LEB128 numbers. Values which manifest.json
+         * parsing drops (null and integers outside the int range) are never written.
+         */
+        constexpr char BinarySignature[] = { 'U', 'S', 'B', 'M' };
+        constexpr unsigned char BinaryVersion = 1;
+
+        enum BinaryTag : unsigned char
+        {
+            BinaryFalse = 1,
+            BinaryTrue = 2,
+            BinaryInt = 3,
+            BinaryDouble = 4,
+            BinaryString = 5,
+            BinaryArray = 6,
+            BinaryObject = 7
+        };
+
+        class BinaryManifestReader
+        {
+          public:
+            explicit BinaryManifestReader(std::string_view data) : m_Data(data) {}
+
+            std::size_t
+            ReadCount()
+            {
+                std::uint64_t value = 0;
+                for (unsigned shift = 0; shift < 64; shift += 7)
+                {
+                    auto const byte = ReadByte();
+                    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        // Every counted item occupies at least one byte, which bounds
+                        // reservations made from counts in corrupt data.
+                        if (value > m_Data.size())
+                        {
+                            break;
+                        }
+                        return static_cast<std::size_t>(value);
+                    }
+                }
+                throw std::runtime_error("Invalid length in binary manifest");
+            }
+
+            std::string_view
+            ReadBytes(std::size_t count)
+            {
+                if (count > m_Data.size())
+                {
+                    throw std::runtime_error("Unexpected end of binary manifest");
+                }
+                auto bytes = m_Data.substr(0, count);
+                m_Data.remove_prefix(count);
+                return bytes;
+            }
+
+            unsigned char
+            ReadByte()
+            {
+                return static_cast<unsigned char>(ReadBytes(1)[0]);
+            }
+
+            std::uint64_t
+            ReadLittleEndian(std::size_t count)
+            {
+                auto const bytes = ReadBytes(count);
+                std::uint64_t value = 0;
+                for (std::size_t i = count; i > 0; --i)
+                {
+                    value = (value << 8) | static_cast<unsigned char>(bytes[i - 1]);
+                }
+                return value;
+            }
+
+            Any
+            ReadValue()
+            {
+                switch (ReadByte())
+                {
+                    case BinaryFalse:
+                        return Any(false);
+                    case BinaryTrue:
+                        return Any(true);
+                    case BinaryInt:
+                        return Any(static_cast<int>(static_cast<std::int32_t>(ReadLittleEndian(4))));
+                    case BinaryDouble:
+                    {
+                        auto const bits = ReadLittleEndian(8);
+                        double value;
+                        std::memcpy(&value, &bits, sizeof value);
+                        return Any(value);
+                    }
+                    case BinaryString:
+                    {
+                        // Same as for manifest.json, drop the leading '%' of localizable values.
+                        auto value = ReadBytes(ReadCount());
+                        if (!value.empty() && value[0] == '%')
+                        {
+                            value.remove_prefix(1);
+                        }
+                        return Any(std::string(value));
+                    }
+                    case BinaryArray:
+                    {
+                        Any any = AnyVector();
+                        auto& vector = ref_any_cast<AnyVector>(any);
+                        auto count = ReadCount();
+                        vector.reserve(count);
+                        while (count-- > 0)
+                        {
+                            vector.emplace_back(ReadValue());
+                        }
+                        return any;
+                    }
+                    case BinaryObject:
+                    {
+                        AnyMap::unordered_any_cimap map;
+                        ReadObject(map);
+                        return MakeAnyMap(std::move(map));
+                    }
+                    default:
+                        throw std::runtime_error("Invalid value type in binary manifest");
+                }
+            }
+
+            void
+            ReadObject(AnyMap::unordered_any_cimap& map)
+            {
+                auto const count = ReadCount();
+                map.reserve(map.size() + count);
+                ReadMembers(map, count);
+            }
+
+            template <class Map>
+            void
+            ReadMembers(Map& map, std::size_t count)
+            {
+                while (count-- > 0)
+                {
+                    std::string key(ReadBytes(ReadCount()));
+                    map.emplace(std::move(key), ReadValue());
+                }
+            }
+
+            bool
+            AtEnd() const
+            {
+                return m_Data.empty();
+            }
+
+          private:
+            std::string_view m_Data;
+        };
+
     } // namespace
 
     BundleManifest::BundleManifest() : m_Headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS) {}
@@ -170,9 +375,14 @@ namespace cppmicroservices
     void
     BundleManifest::Parse(std::istream& is)
     {
-        rapidjson::IStreamWrapper jsonStream(is);
-        rapidjson::Document root;
-        if (root.ParseStream(jsonStream).HasParseError())
+        // Read the whole manifest in one go and parse it in-situ: string values in the
+        // resulting DOM then point into this buffer instead of being copied one by one.
+        std::string json { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+
+        char arenaBuffer[ParseArenaSize];
+        ArenaAllocator arena(arenaBuffer, sizeof(arenaBuffer));
+        ArenaDocument root(&arena);
+        if (root.ParseInsitu(&json[0]).HasParseError())
         {
             throw std::runtime_error(rapidjson::GetParseError_En(root.GetParseError()));
         }
@@ -182,7 +392,62 @@ namespace cppmicroservices
             throw std::runtime_error("The Json root element must be an object.");
         }
 
-        ParseJsonObject(root, m_Headers);
+        if (m_Headers.empty() && m_Headers.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        {
+            AnyMap::unordered_any_cimap headers;
+            ParseJsonObject(root, headers);
+            m_Headers = AnyMap(std::move(headers));
+        }
+        else
+        {
+            for (auto const& m : root.GetObject())
+            {
+                Any anyValue = ParseJsonValue(m.value, true);
+                if (!anyValue.Empty())
+                {
+                    m_Headers.emplace(ToString(m.name), std::move(anyValue));
+                }
+            }
+        }
+    }
+
+    bool
+    BundleManifest::IsBinary(std::string_view data)
+    {
+        return data.size() > sizeof(BinarySignature)
+               && 0 == std::memcmp(data.data(), BinarySignature, sizeof(BinarySignature))
+               && static_cast<unsigned char>(data[sizeof(BinarySignature)]) == BinaryVersion;
+    }
+
+    void
+    BundleManifest::ParseBinary(std::string_view data)
+    {
+        if (!IsBinary(data))
+        {
+            throw std::runtime_error("Not a binary manifest of a supported version.");
+        }
+
+        BinaryManifestReader reader(data.substr(sizeof(BinarySignature) + 1));
+        if (reader.ReadByte() != BinaryObject)
+        {
+            throw std::runtime_error("The binary manifest root element must be an object.");
+        }
+
+        if (m_Headers.empty() && m_Headers.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        {
+            AnyMap::unordered_any_cimap headers;
+            reader.ReadObject(headers);
+            m_Headers = AnyMap(std::move(headers));
+        }
+        else
+        {
+            reader.ReadMembers(m_Headers, reader.ReadCount());
+        }
+
+        if (!reader.AtEnd())
+        {
+            throw std::runtime_error("Unexpected data after the binary manifest root element.");
+        }
     }
 
     AnyMap const&
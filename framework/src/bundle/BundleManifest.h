@@ -26,6 +26,7 @@
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/AnyMap.h"
 #include <mutex>
+#include <string_view>
 
 namespace cppmicroservices
 {
@@ -39,6 +40,21 @@ namespace cppmicroservices
 
         void Parse(std::istream& is);
 
+        /**
+         * Load the headers from the binary manifest which usResourceCompiler writes
+         * next to manifest.json when called with --binary-manifest. The result is
+         * the same as parsing the corresponding manifest.json.
+         *
+         * @throws std::runtime_error if the data is not a valid binary manifest.
+         */
+        void ParseBinary(std::string_view data);
+
+        /**
+         * Check whether the data starts with the signature of a binary manifest
+         * in a format version this framework can read.
+         */
+        static bool IsBinary(std::string_view data);
+
         AnyMap const& GetHeaders() const;
 
         bool Contains(std::string const& key) const;
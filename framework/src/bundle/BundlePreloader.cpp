@@ -0,0 +1,231 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundlePreloader.h"
+
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/FrameworkEvent.h"
+
+#include "cppmicroservices/util/FileSystem.h"
+
+#include "BundlePrivate.h"
+#include "BundleRegistry.h"
+#include "CoreBundleContext.h"
+#include "FrameworkPrivate.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef US_PLATFORM_LINUX
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace cppmicroservices
+{
+
+    namespace
+    {
+
+        // Get the file system to read the file ahead into its cache.
+        void
+        ReadAhead(std::string const& path)
+        {
+#ifdef US_PLATFORM_LINUX
+            int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd != -1)
+            {
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                close(fd);
+            }
+#else
+            std::ifstream file(path, std::ios_base::binary);
+            std::vector<char> buffer(64 * 1024);
+            while (file.read(buffer.data(), buffer.size()))
+            {
+            }
+#endif
+        }
+
+        bool
+        GetBoolHeader(AnyMap const& headers, std::string const& key)
+        {
+            auto iter = headers.find(key);
+            return iter != headers.end() && iter->second.Type() == typeid(bool) && any_cast<bool>(iter->second);
+        }
+
+    } // namespace
+
+    BundlePreloader::BundlePreloader(CoreBundleContext* coreCtx) : coreCtx(coreCtx), open(false) {}
+
+    BundlePreloader::~BundlePreloader() { Close(); }
+
+    void
+    BundlePreloader::Open()
+    {
+#ifdef US_ENABLE_THREADING_SUPPORT
+        if (!any_cast<bool>(coreCtx->frameworkProperties.at(Constants::FRAMEWORK_BUNDLE_PRELOAD)))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (open)
+            {
+                return;
+            }
+            open = true;
+            for (auto const& bundle : coreCtx->bundleRegistry->GetBundles())
+            {
+                if (bundle != coreCtx->systemBundle)
+                {
+                    queue.push_back(bundle);
+                }
+            }
+        }
+        worker = std::thread(&BundlePreloader::Run, this);
+#endif
+    }
+
+    void
+    BundlePreloader::Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = false;
+            queue.clear();
+        }
+        cv.notify_all();
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+
+    void
+    BundlePreloader::Preload(std::shared_ptr<BundlePrivate> const& bundle)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!open)
+            {
+                return;
+            }
+            queue.push_back(bundle);
+        }
+        cv.notify_one();
+    }
+
+    void
+    BundlePreloader::Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [this] { return !queue.empty() || !open; });
+            if (!open)
+            {
+                return;
+            }
+            auto bundle = queue.front().lock();
+            queue.pop_front();
+            lock.unlock();
+
+            if (bundle)
+            {
+                Preload0(bundle);
+            }
+
+            lock.lock();
+        }
+    }
+
+    void
+    BundlePreloader::Preload0(std::shared_ptr<BundlePrivate> const& b)
+    {
+        if (b->state == Bundle::STATE_UNINSTALLED)
+        {
+            return;
+        }
+
+        auto const path = b->lib->GetFilePath();
+        try
+        {
+            // Bundles embedded in the executable need no loading.
+            if (path.empty() || path == util::GetExecutablePath())
+            {
+                return;
+            }
+        }
+        catch (...)
+        {
+            return;
+        }
+
+        ReadAhead(path);
+
+        // Start0 loads the library only for bundles with an activator.
+        auto const& headers = b->bundleManifest.GetHeaders();
+        if (!GetBoolHeader(headers, Constants::BUNDLE_PRELOAD) || !GetBoolHeader(headers, Constants::BUNDLE_ACTIVATOR))
+        {
+            return;
+        }
+
+        // Libraries are validated by Start0 before they are loaded, on the
+        // thread starting the bundle, so they are only read ahead here.
+        if (coreCtx->validationFunc)
+        {
+            return;
+        }
+
+        auto const bundle = MakeBundle(b);
+        auto const begin = std::chrono::steady_clock::now();
+        try
+        {
+            if (!b->LoadSharedLibrary())
+            {
+                return;
+            }
+        }
+        catch (...)
+        {
+            coreCtx->listeners.SendFrameworkEvent(
+                FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
+                               bundle,
+                               "Failed to preload shared library for Bundle " + b->symbolicName
+                                   + " (location=" + b->location + ")",
+                               std::current_exception()));
+            return;
+        }
+        auto const elapsed
+            = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+        coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_INFO,
+                                                             bundle,
+                                                             "Preloaded shared library for Bundle " + b->symbolicName
+                                                                 + " (location=" + b->location + ") in "
+                                                                 + std::to_string(elapsed.count()) + " us"));
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,85 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLEPRELOADER_H
+#define CPPMICROSERVICES_BUNDLEPRELOADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cppmicroservices
+{
+
+    class BundlePrivate;
+    class CoreBundleContext;
+
+    /**
+     * Reads the shared libraries of installed bundles ahead and loads the ones
+     * marked with the bundle.preload manifest header on a background thread,
+     * see Constants::FRAMEWORK_BUNDLE_PRELOAD.
+     */
+    class BundlePreloader
+    {
+      public:
+        explicit BundlePreloader(CoreBundleContext* coreCtx);
+        ~BundlePreloader();
+
+        BundlePreloader(BundlePreloader const&) = delete;
+        BundlePreloader& operator=(BundlePreloader const&) = delete;
+
+        /**
+         * Start the background thread if the framework preloads bundles, and
+         * queue all bundles installed so far. Must be called after the library
+         * load options of the framework are set.
+         */
+        void Open();
+
+        /**
+         * Discard the queued bundles and wait for the background thread to
+         * finish the bundle it is working on.
+         */
+        void Close();
+
+        /**
+         * Queue a bundle for preloading. Does nothing if the preloader is not open.
+         */
+        void Preload(std::shared_ptr<BundlePrivate> const& bundle);
+
+      private:
+        void Run();
+
+        void Preload0(std::shared_ptr<BundlePrivate> const& bundle);
+
+        CoreBundleContext* const coreCtx;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::weak_ptr<BundlePrivate>> queue;
+        bool open;
+        std::thread worker;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_BUNDLEPRELOADER_H
@@ -46,7 +46,6 @@
 #include "BundleResourceContainer.h"
 #include "BundleUtils.h"
 #include "CoreBundleContext.h"
-#include "ServiceReferenceBasePrivate.h"
 
 #include <algorithm>
 #include <cassert>
@@ -57,6 +56,45 @@
 namespace cppmicroservices
 {
 
+    namespace
+    {
+
+        /**
+         * Load the binary manifest of the bundle archive, if it has one.
+         *
+         * @return false if the archive contains no binary manifest in a supported
+         *         format version, in which case manifest.json has to be parsed.
+         */
+        bool
+        ParseBinaryManifest(BundleArchive const& ba, BundleManifest& manifest)
+        {
+            auto binaryRes = ba.GetResource("/manifest.bin");
+            if (!binaryRes)
+            {
+                return false;
+            }
+
+            // The resource compiler stores the binary manifest uncompressed, so it
+            // can usually be read in place.
+            std::string buffer;
+            auto data = binaryRes.GetStoredData();
+            if (data.empty())
+            {
+                BundleResourceStream binaryStream(binaryRes, std::ios_base::binary);
+                buffer.assign(std::istreambuf_iterator<char>(binaryStream), std::istreambuf_iterator<char>());
+                data = buffer;
+            }
+
+            if (!BundleManifest::IsBinary(data))
+            {
+                return false;
+            }
+            manifest.ParseBinary(data);
+            return true;
+        }
+
+    } // namespace
+
     Bundle
     MakeBundle(std::shared_ptr<BundlePrivate> const& d)
     {
@@ -124,6 +162,17 @@ namespace cppmicroservices
     {
         std::exception_ptr res;
 
+        if (coreCtx->fastShutdown)
+        {
+            // The framework is shutting down, a stopping bundle does not
+            // receive events any more.
+            if (auto ctx = bundleContext.Load())
+            {
+                coreCtx->listeners.HooksBundleStopped(ctx);
+                coreCtx->listeners.RemoveAllListeners(ctx);
+            }
+        }
+
         coreCtx->listeners.BundleChanged(
             BundleEvent(BundleEvent::BUNDLE_STOPPING, MakeBundle(this->shared_from_this())));
 
@@ -522,16 +571,7 @@ namespace cppmicroservices
                 }
                 else
                 {
-                    if (!lib->IsLoaded())
-                    {
-                        coreCtx->logger->Log(logservice::SeverityLevel::LOG_INFO,
-                                             "Loading shared library for Bundle " + symbolicName
-                                                 + " (location=" + location + ")");
-                        lib->Load(coreCtx->libraryLoadOptions);
-                        coreCtx->logger->Log(logservice::SeverityLevel::LOG_INFO,
-                                             "Finished loading shared library for Bundle " + symbolicName
-                                                 + " (location=" + location + ")");
-                    }
+                    LoadSharedLibrary();
                     libHandle = lib->GetHandle();
                 }
 
@@ -576,6 +616,8 @@ namespace cppmicroservices
                 }
 
                 // get a BundleActivator instance
+                StartupProfiler::Span span(coreCtx->profiler, "BundleActivator::Start", "bundle");
+                span.AddArg("bundle", symbolicName);
                 bactivator = std::unique_ptr<BundleActivator, DestroyActivatorHook>(createActivatorHook(),
                                                                                     destroyActivatorHook);
                 bactivator->Start(MakeBundleContext(ctx));
@@ -659,6 +701,28 @@ namespace cppmicroservices
         return res;
     }
 
+    bool
+    BundlePrivate::LoadSharedLibrary()
+    {
+        std::lock_guard<std::mutex> lock(libMutex);
+        if (lib->IsLoaded())
+        {
+            return false;
+        }
+
+        StartupProfiler::Span span(coreCtx->profiler, "Load library", "bundle");
+        span.AddArg("bundle", symbolicName);
+        span.AddArg("location", location);
+
+        coreCtx->logger->Log(logservice::SeverityLevel::LOG_INFO,
+                             "Loading shared library for Bundle " + symbolicName + " (location=" + location + ")");
+        lib->Load(coreCtx->libraryLoadOptions);
+        coreCtx->logger->Log(logservice::SeverityLevel::LOG_INFO,
+                             "Finished loading shared library for Bundle " + symbolicName + " (location=" + location
+                                 + ")");
+        return true;
+    }
+
     void
     BundlePrivate::StartFailed()
     {
@@ -694,6 +758,7 @@ namespace cppmicroservices
         , version(CppMicroServices_VERSION_MAJOR, CppMicroServices_VERSION_MINOR, CppMicroServices_VERSION_PATCH)
         , timeStamp(std::chrono::steady_clock::now())
         , bundleManifest()
+        , startLevel(0)
         , lib(std::make_unique<SharedLibrary>())
         , bundleUtils(std::make_unique<BundleUtils>())
         , SetBundleContext(nullptr)
@@ -718,6 +783,7 @@ namespace cppmicroservices
         , version()
         , timeStamp(ba->GetLastModified())
         , bundleManifest(ba->GetInjectedManifest())
+        , startLevel(1)
         , lib(std::make_unique<SharedLibrary>(location))
         , bundleUtils(std::make_unique<BundleUtils>())
         , SetBundleContext(nullptr)
@@ -732,10 +798,16 @@ namespace cppmicroservices
                 auto manifestRes = ba->GetResource("/manifest.json");
                 if (manifestRes)
                 {
-                    BundleResourceStream manifestStream(manifestRes);
+                    StartupProfiler::Span span(coreCtx->profiler, "Parse manifest", "install");
+                    span.AddArg("bundle", symbolicName);
                     try
                     {
-                        bundleManifest.Parse(manifestStream);
+                        // Prefer the pre-parsed manifest written by the resource compiler.
+                        if (!ParseBinaryManifest(*ba, bundleManifest))
+                        {
+                            BundleResourceStream manifestStream(manifestRes);
+                            bundleManifest.Parse(manifestStream);
+                        }
                     }
                     catch (...)
                     {
@@ -743,6 +815,10 @@ namespace cppmicroservices
                                                  + ba->GetResourcePrefix() + " at " + location
                                                  + " failed: " + util::GetLastExceptionStr());
                     }
+                    if (coreCtx->storage->IsPersistent())
+                    {
+                        ba->SetManifest(bundleManifest.GetHeaders());
+                    }
                     // It is unlikely that clients will access bundle resources
                     // if the only resource is the manifest file. On this assumption,
                     // close the open file handle to the zip file to improve performance
@@ -795,6 +871,18 @@ namespace cppmicroservices
                                         + symbolicName + "(location=" + location + ").");
         }
 
+        if (bundleManifest.Contains(Constants::BUNDLE_STARTLEVEL))
+        {
+            Any startLevelAny = bundleManifest.GetValue(Constants::BUNDLE_STARTLEVEL);
+            if (startLevelAny.Type() != typeid(int) || ref_any_cast<int>(startLevelAny) < 1)
+            {
+                throw std::invalid_argument(std::string("The Json value for ") + Constants::BUNDLE_STARTLEVEL
+                                            + " for bundle " + symbolicName + " (location=" + location
+                                            + ") is not valid: The start level must be a positive integer");
+            }
+            startLevel = ref_any_cast<int>(startLevelAny);
+        }
+
         auto snbl = coreCtx->bundleRegistry->GetBundles(symbolicName, version);
         if (!snbl.empty())
         {
@@ -822,6 +910,12 @@ namespace cppmicroservices
 
         std::vector<ServiceRegistrationBase> srs;
         coreCtx->services.GetRegisteredByBundle(this, srs);
+        if (coreCtx->fastShutdown)
+        {
+            // Take all services out of the registry at once instead of
+            // scanning it for each of them
+            coreCtx->services.RemoveServiceRegistrations(srs);
+        }
         for (auto& sr : srs)
         {
             try
@@ -836,25 +930,7 @@ namespace cppmicroservices
             }
         }
 
-        srs.clear();
-        coreCtx->services.GetUsedByBundle(this, srs);
-        for (std::vector<ServiceRegistrationBase>::const_iterator i = srs.begin(); i != srs.end(); ++i)
-        {
-            // wrap in try-catch to catch failures if service is already unregistered
-            // if service is unregistered, all work in UngetService is already done by Unregister() previously
-            try
-            {
-                auto ref = i->GetReference(std::string());
-                ref.d.Load()->UngetService(this->shared_from_this(), false);
-            }
-            catch (...)
-            {
-                coreCtx->logger->Log(logservice::SeverityLevel::LOG_WARNING,
-                                     "Some services already unregistered in Bundle " + symbolicName
-                                         + " (location=" + location + ")",
-                                     std::current_exception());
-            }
-        }
+        coreCtx->services.UngetServicesUsedByBundle(this);
     }
 
     void
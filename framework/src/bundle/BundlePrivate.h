@@ -36,8 +36,10 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <thread>
+#include <unordered_map>
 
 namespace cppmicroservices
 {
@@ -45,6 +47,7 @@ namespace cppmicroservices
     class CoreBundleContext;
     class Bundle;
     class BundleContextPrivate;
+    class ServiceRegistrationBasePrivate;
     struct BundleActivator;
 
     /**
@@ -160,6 +163,14 @@ namespace cppmicroservices
          */
         std::exception_ptr Start0();
 
+        /**
+         * Load the shared library of the bundle unless it is already loaded.
+         * Called by Start0 and by the BundlePreloader, possibly concurrently.
+         *
+         * @return true if this call loaded the library.
+         */
+        bool LoadSharedLibrary();
+
         void StartFailed();
 
         /**
@@ -199,6 +210,17 @@ namespace cppmicroservices
          */
         detail::Atomic<std::shared_ptr<BundleContextPrivate>> bundleContext;
 
+        /**
+         * Reverse index of the service registrations this bundle has started to
+         * use. Entries are added while holding the locks of the registration, and
+         * are pruned lazily when the bundle no longer uses the service; see
+         * ServiceRegistry::GetUsedByBundle.
+         */
+        struct : detail::MultiThreaded<>
+        {
+            std::unordered_map<ServiceRegistrationBasePrivate*, std::weak_ptr<ServiceRegistrationBasePrivate>> v;
+        } usedServices;
+
         using DestroyActivatorHook = std::function<void(BundleActivator*)>;
 
         DestroyActivatorHook destroyActivatorHook;
@@ -262,6 +284,12 @@ namespace cppmicroservices
         // Does not need to be locked by "this" when accessed.
         BundleManifest bundleManifest;
 
+        /**
+         * Bundle start level, see Constants::BUNDLE_STARTLEVEL.
+         */
+        // Does not need to be locked by "this" when accessed.
+        int startLevel;
+
         // -------------------------------------------------------------------------------
 
         /**
@@ -270,6 +298,11 @@ namespace cppmicroservices
          */
         std::unique_ptr<SharedLibrary> lib;
 
+        /**
+         * Serializes loading lib, see LoadSharedLibrary().
+         */
+        std::mutex libMutex;
+
         std::unique_ptr<BundleUtils> bundleUtils;
 
         SetBundleContextFn SetBundleContext;
@@ -38,10 +38,15 @@
 #include "CoreBundleContext.h"
 #include "FrameworkPrivate.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <deque>
 #include <functional>
+#include <future>
 #include <map>
+#include <set>
+#include <thread>
 
 namespace
 {
@@ -57,6 +62,50 @@ namespace
         std::function<void()> _cleanupFcn;
     };
 
+    // Calls fn(i) for each i in [0, count) on up to one worker thread per core,
+    // the calling thread being one of them. fn must not throw.
+    template <typename Fn>
+    void
+    ParallelFor(std::size_t count, Fn const& fn)
+    {
+#ifdef US_ENABLE_THREADING_SUPPORT
+        std::size_t const workers = std::min<std::size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+#else
+        std::size_t const workers = 1;
+#endif
+        std::atomic<std::size_t> next { 0 };
+        auto work = [&]()
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+            {
+                fn(i);
+            }
+        };
+
+        std::vector<std::future<void>> helpers;
+        for (std::size_t w = 1; w < workers; ++w)
+        {
+            helpers.push_back(std::async(std::launch::async, work));
+        }
+        work();
+        for (auto& helper : helpers)
+        {
+            helper.get();
+        }
+    }
+
+    // Open the resource container of a bundle file, which scans the zip
+    // directory, and record the time it took in the start-up timeline.
+    std::shared_ptr<cppmicroservices::BundleResourceContainer>
+    OpenResourceContainer(cppmicroservices::CoreBundleContext* coreCtx,
+                          std::string const& location,
+                          cppmicroservices::AnyMap const& bundleManifest)
+    {
+        cppmicroservices::StartupProfiler::Span span(coreCtx->profiler, "Scan bundle file", "install");
+        span.AddArg("location", location);
+        return std::make_shared<cppmicroservices::BundleResourceContainer>(location, bundleManifest);
+    }
+
 } // namespace
 
 namespace cppmicroservices
@@ -69,7 +118,7 @@ namespace cppmicroservices
     void
     BundleRegistry::Init()
     {
-        bundles.v.insert(std::make_pair(coreCtx->systemBundle->location, coreCtx->systemBundle));
+        bundles.Add(coreCtx->systemBundle->location, coreCtx->systemBundle);
     }
 
     void
@@ -77,7 +126,40 @@ namespace cppmicroservices
     {
         auto l = bundles.Lock();
         US_UNUSED(l);
-        bundles.v.clear();
+        bundles.Clear();
+    }
+
+    void
+    BundleRegistry::BundleTable::Add(std::string const& location, std::shared_ptr<BundlePrivate> const& b)
+    {
+        v.insert(std::make_pair(location, b));
+        byId.emplace(b->id, b);
+        byName.emplace(b->symbolicName, b);
+    }
+
+    void
+    BundleRegistry::BundleTable::Erase(BundleMap::iterator iter)
+    {
+        auto const& b = iter->second;
+        byId.erase(b->id);
+        auto range = byName.equal_range(b->symbolicName);
+        for (auto nameIter = range.first; nameIter != range.second; ++nameIter)
+        {
+            if (nameIter->second == b)
+            {
+                byName.erase(nameIter);
+                break;
+            }
+        }
+        v.erase(iter);
+    }
+
+    void
+    BundleRegistry::BundleTable::Clear()
+    {
+        v.clear();
+        byId.clear();
+        byName.clear();
     }
 
     /*
@@ -119,7 +201,7 @@ namespace cppmicroservices
         // First, get a BundleResourceContainer to work with. Either create a new one (if one hasn't been
         // made yet for this location), or use one from another BundleArchive at this location.
         auto resourceContainer = (foundBundles.first == foundBundles.second
-                                      ? std::make_shared<BundleResourceContainer>(location, bundleManifest)
+                                      ? OpenResourceContainer(coreCtx, location, bundleManifest)
                                       : foundBundles.first->second->GetBundleArchive()->GetResourceContainer());
 
         while (foundBundles.first != foundBundles.second)
@@ -255,7 +337,7 @@ namespace cppmicroservices
                     // Perform the install
                     if (resCont == nullptr)
                     {
-                        resContPtr = std::make_shared<BundleResourceContainer>(location, bundleManifest);
+                        resContPtr = OpenResourceContainer(coreCtx, location, bundleManifest);
                     }
                     else
                     {
@@ -326,6 +408,218 @@ namespace cppmicroservices
         }
     }
 
+    std::vector<Bundle>
+    BundleRegistry::Install(std::vector<std::string> const& locations, BundlePrivate*)
+    {
+        CheckIllegalState();
+
+        // Claim the locations which are neither installed nor being installed by another
+        // thread. The remaining ones, including repeated locations, take the regular install
+        // path afterwards, which waits for concurrent installs and returns installed bundles.
+        std::vector<std::string> claimed;
+        std::vector<std::size_t> claimedIndices;
+        auto l = this->Lock();
+        US_UNUSED(l);
+        for (std::size_t i = 0; i < locations.size(); ++i)
+        {
+            auto const& location = locations[i];
+            if ((bundles.Lock(), bundles.v.count(location)) == 0 && initialBundleInstallMap.count(location) == 0)
+            {
+                initialBundleInstallMap.insert(std::make_pair(location, std::make_pair(uint32_t(1), WaitCondition {})));
+                claimed.push_back(location);
+                claimedIndices.push_back(i);
+            }
+        }
+        l.UnLock();
+
+        std::vector<std::vector<Bundle>> installed(locations.size());
+        {
+            // create instance of clean-up object to ensure RAII
+            InitialBundleMapCleanup cleanup(
+                [this, &l, &claimed]()
+                {
+                    for (auto const& location : claimed)
+                    {
+                        {
+                            l.Lock();
+                            auto& p = initialBundleInstallMap[location];
+                            // Notify all waiting threads that it is safe to install the bundle
+                            std::lock_guard<std::mutex> lock(*(p.second.m));
+                            p.second.waitFlag = false;
+                            p.second.cv->notify_all();
+                            l.UnLock();
+                        }
+                        DecrementInitialBundleMapRef(l, location);
+                    }
+                });
+
+            auto claimedBundles = InstallParallel0(claimed);
+            for (std::size_t i = 0; i < claimedIndices.size(); ++i)
+            {
+                installed[claimedIndices[i]] = std::move(claimedBundles[i]);
+            }
+        }
+
+        std::vector<Bundle> result;
+        std::size_t nextClaimed = 0;
+        for (std::size_t i = 0; i < locations.size(); ++i)
+        {
+            if (nextClaimed < claimedIndices.size() && claimedIndices[nextClaimed] == i)
+            {
+                ++nextClaimed;
+            }
+            else
+            {
+                installed[i] = InstallWithContainer(locations[i],
+                                                    AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS),
+                                                    nullptr);
+            }
+            result.insert(result.end(), installed[i].begin(), installed[i].end());
+        }
+        return result;
+    }
+
+    std::vector<std::vector<Bundle>>
+    BundleRegistry::InstallParallel0(std::vector<std::string> const& locations)
+    {
+        struct PendingLocation
+        {
+            std::shared_ptr<BundleResourceContainer> resCont;
+            std::vector<std::shared_ptr<BundleArchive>> barchives;
+            std::vector<std::shared_ptr<BundlePrivate>> bundles;
+            std::exception_ptr error;
+        };
+        std::vector<PendingLocation> pending(locations.size());
+
+        auto rethrowFirstError = [&pending, &locations](std::string& failedLocation)
+        {
+            for (std::size_t i = 0; i < pending.size(); ++i)
+            {
+                if (pending[i].error)
+                {
+                    failedLocation = locations[i];
+                    std::rethrow_exception(pending[i].error);
+                }
+            }
+        };
+
+        std::string failedLocation;
+        try
+        {
+            // Open the bundle libraries and read their zip directories in parallel.
+            ParallelFor(locations.size(),
+                        [this, &pending, &locations](std::size_t i)
+                        {
+                            try
+                            {
+                                pending[i].resCont = OpenResourceContainer(
+                                    coreCtx,
+                                    locations[i],
+                                    AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+                            }
+                            catch (...)
+                            {
+                                pending[i].error = std::current_exception();
+                            }
+                        });
+            rethrowFirstError(failedLocation);
+
+            // Create the bundle archives one location after the other, so that bundle ids
+            // follow the order of the locations.
+            for (std::size_t i = 0; i < locations.size(); ++i)
+            {
+                failedLocation = locations[i];
+                for (auto const& symbolicName : pending[i].resCont->GetTopLevelDirs())
+                {
+#ifndef US_BUILD_SHARED_LIBS
+                    // The system bundle is already installed, so skip it.
+                    if (Constants::SYSTEM_BUNDLE_SYMBOLICNAME == symbolicName)
+                    {
+                        continue;
+                    }
+#endif
+                    pending[i].barchives.push_back(
+                        coreCtx->storage->CreateAndInsertArchive(pending[i].resCont,
+                                                                 symbolicName,
+                                                                 AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS)));
+                }
+            }
+
+            // Parse the manifests in parallel.
+            ParallelFor(locations.size(),
+                        [this, &pending](std::size_t i)
+                        {
+                            try
+                            {
+                                for (auto const& ba : pending[i].barchives)
+                                {
+                                    pending[i].bundles.push_back(std::make_shared<BundlePrivate>(coreCtx, ba));
+                                }
+                            }
+                            catch (...)
+                            {
+                                pending[i].error = std::current_exception();
+                            }
+                        });
+            rethrowFirstError(failedLocation);
+
+            // BundlePrivate only checked for duplicates among the installed bundles.
+            std::set<std::pair<std::string, std::string>> symbolicNamesAndVersions;
+            for (std::size_t i = 0; i < locations.size(); ++i)
+            {
+                for (auto const& b : pending[i].bundles)
+                {
+                    if (!symbolicNamesAndVersions.insert(std::make_pair(b->symbolicName, b->version.ToString()))
+                             .second)
+                    {
+                        failedLocation = locations[i];
+                        throw std::invalid_argument("Bundle " + b->symbolicName + " (location=" + b->location
+                                                    + "), a bundle with same symbolic name and version "
+                                                    + "is already installed (" + b->symbolicName + ", "
+                                                    + b->version.ToString() + ")");
+                    }
+                }
+            }
+
+            // Add all bundles to the registry in one step.
+            auto l = bundles.Lock();
+            US_UNUSED(l);
+            for (std::size_t i = 0; i < locations.size(); ++i)
+            {
+                for (auto const& b : pending[i].bundles)
+                {
+                    bundles.Add(locations[i], b);
+                }
+            }
+        }
+        catch (...)
+        {
+            for (auto& p : pending)
+            {
+                for (auto& ba : p.barchives)
+                {
+                    ba->Purge();
+                }
+            }
+
+            throw std::runtime_error("Failed to install bundle library at " + failedLocation + ": "
+                                     + util::GetLastExceptionStr());
+        }
+
+        // Fire the bundle event listeners in the order of the locations.
+        std::vector<std::vector<Bundle>> installedBundles(locations.size());
+        for (std::size_t i = 0; i < locations.size(); ++i)
+        {
+            for (auto const& b : pending[i].bundles)
+            {
+                coreCtx->preloader.Preload(b);
+                installedBundles[i].emplace_back(MakeBundle(b));
+                coreCtx->listeners.BundleChanged(BundleEvent(BundleEvent::BUNDLE_INSTALLED, installedBundles[i].back()));
+            }
+        }
+        return installedBundles;
+    }
+
     std::vector<Bundle>
     BundleRegistry::Install0(std::string const& location,
                              std::shared_ptr<BundleResourceContainer> const& resCont,
@@ -340,6 +634,9 @@ namespace cppmicroservices
         std::vector<Bundle> installedBundles;
         std::vector<std::shared_ptr<BundleArchive>> barchives;
         std::unordered_set<std::string> exclude { alreadyInstalled.begin(), alreadyInstalled.end() };
+
+        StartupProfiler::Span span(coreCtx->profiler, "Install", "install");
+        span.AddArg("location", location);
         try
         {
             // Create a BundleArchive for each entry in the resource container... that is, top level entries
@@ -390,13 +687,14 @@ namespace cppmicroservices
                 US_UNUSED(l);
                 for (auto& b : installedBundles)
                 {
-                    bundles.v.insert(std::make_pair(location, b.d));
+                    bundles.Add(location, b.d);
                 }
             }
 
             // Now fire off the bundle event listeners.
             for (auto& b : installedBundles)
             {
+                coreCtx->preloader.Preload(b.d);
                 coreCtx->listeners.BundleChanged(BundleEvent(BundleEvent::BUNDLE_INSTALLED, b));
             }
         }
@@ -424,7 +722,7 @@ namespace cppmicroservices
         {
             if (iter->second->id == id)
             {
-                bundles.v.erase(iter);
+                bundles.Erase(iter);
                 return;
             }
         }
@@ -438,14 +736,8 @@ namespace cppmicroservices
         auto l = bundles.Lock();
         US_UNUSED(l);
 
-        for (auto& m : bundles.v)
-        {
-            if (m.second->id == id)
-            {
-                return m.second;
-            }
-        }
-        return nullptr;
+        auto iter = bundles.byId.find(id);
+        return iter != bundles.byId.end() ? iter->second : nullptr;
     }
 
     std::vector<std::shared_ptr<BundlePrivate>>
@@ -475,12 +767,12 @@ namespace cppmicroservices
         auto l = bundles.Lock();
         US_UNUSED(l);
 
-        for (auto& p : bundles.v)
+        auto range = bundles.byName.equal_range(name);
+        for (auto iter = range.first; iter != range.second; ++iter)
         {
-            auto& b = p.second;
-            if (name == b->symbolicName && version == b->version)
+            if (version == iter->second->version)
             {
-                res.push_back(b);
+                res.push_back(iter->second);
             }
         }
 
@@ -531,11 +823,12 @@ namespace cppmicroservices
             try
             {
                 auto impl = std::make_shared<BundlePrivate>(coreCtx, ba);
-                bundles.v.insert(std::make_pair(impl->location, impl));
+                bundles.Add(impl->location, impl);
             }
             catch (...)
             {
                 ba->SetAutostartSetting(-1); // Do not start on launch
+                ba->Purge();
                 std::cerr << "Failed to load bundle " << util::ToString(ba->GetBundleId())
                           << " (" + ba->GetBundleLocation() + ") uninstalled it!"
                           << " (exception: " << util::GetExceptionStr(std::current_exception()) << ")" << std::endl;
@@ -30,6 +30,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "BundleResourceContainer.h"
@@ -71,6 +72,17 @@ namespace cppmicroservices
                                     cppmicroservices::AnyMap const& bundleManifest = cppmicroservices::AnyMap(
                                         cppmicroservices::any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
 
+        /**
+         * Install the bundle libraries at several locations. The libraries are
+         * inspected and their manifests parsed in parallel, the bundles are added
+         * to the registry in one step.
+         *
+         * @param locations The locations to be installed
+         * @param caller The bundle performing the install
+         * @return A vector of bundles installed, in the order of the locations
+         */
+        std::vector<Bundle> Install(std::vector<std::string> const& locations, BundlePrivate* caller);
+
         /**
          * Remove bundle registration.
          *
@@ -144,6 +156,14 @@ namespace cppmicroservices
                                      std::vector<std::string> const& alreadyInstalled,
                                      cppmicroservices::AnyMap const& bundleManifest);
 
+        /**
+         * Install the bundles at locations which are neither installed nor being
+         * installed by another thread. Either all bundles are installed or none.
+         *
+         * @return The bundles installed at each location.
+         */
+        std::vector<std::vector<Bundle>> InstallParallel0(std::vector<std::string> const& locations);
+
         void CheckIllegalState() const;
 
         /** This function populates the res and alreadyInstalled vectors with the appropriate entries so
@@ -192,11 +212,19 @@ namespace cppmicroservices
 
         /**
          * Table of all installed bundles in this framework.
-         * Key is the bundle location.
+         * Key is the bundle location. The table is indexed by bundle
+         * id and by symbolic name; Add, Erase and Clear keep the indexes
+         * in sync and must be called with the lock held.
          */
-        struct : MultiThreaded<>
+        struct BundleTable : MultiThreaded<>
         {
             BundleMap v;
+            std::unordered_map<long, std::shared_ptr<BundlePrivate>> byId;
+            std::unordered_multimap<std::string, std::shared_ptr<BundlePrivate>> byName;
+
+            void Add(std::string const& location, std::shared_ptr<BundlePrivate> const& b);
+            void Erase(BundleMap::iterator iter);
+            void Clear();
         } bundles;
 
         friend class MockedEnvironment;
@@ -29,6 +29,7 @@
 #include "BundleResourceContainer.h"
 
 #include <atomic>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -52,6 +53,10 @@ namespace cppmicroservices
 
         mutable std::vector<std::string> children;
         mutable std::vector<uint32_t> childNodes;
+
+        mutable std::once_flag storedDataFlag;
+        mutable std::shared_ptr<char const> storedData;
+        mutable std::size_t storedSize = 0;
     };
 
     void
@@ -280,15 +285,35 @@ namespace cppmicroservices
         return std::hash<std::string>()(d->archive->GetResourcePrefix() + this->GetResourcePath());
     }
 
-    std::unique_ptr<void, void (*)(void*)>
-    BundleResource::GetData() const
+    std::string_view
+    BundleResource::GetStoredData() const
+    {
+        if (!IsValid() || d->stat.isDir)
+        {
+            return {};
+        }
+
+        std::call_once(d->storedDataFlag,
+                       [this]
+                       { d->storedData = d->archive->GetResourceContainer()->GetStoredData(d->stat.index, d->storedSize); });
+        if (!d->storedData)
+        {
+            return {};
+        }
+        return { d->storedData.get(), d->storedSize };
+    }
+
+    std::function<std::function<std::size_t(char const*&)>()>
+    BundleResource::OpenData() const
     {
         if (!IsValid())
         {
-            return { nullptr, ::free };
+            return [] { return [](char const*&) -> std::size_t { return 0; }; };
         }
 
-        return d->archive->GetResourceContainer()->GetData(d->stat.index);
+        auto container = d->archive->GetResourceContainer();
+        auto const index = d->stat.index;
+        return [container, index] { return container->ReadData(index); };
     }
 
     std::ostream&
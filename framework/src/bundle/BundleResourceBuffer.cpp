@@ -22,11 +22,15 @@
 
 #include "cppmicroservices/detail/BundleResourceBuffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <limits>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 #ifdef US_PLATFORM_WINDOWS
 #    define DATA_NEEDS_NEWLINE_CONVERSION 1
@@ -42,64 +46,271 @@ namespace cppmicroservices
     namespace detail
     {
 
+        namespace
+        {
+            BundleResourceBuffer::OpenFunction
+            OpenContiguous(std::shared_ptr<void const> data, std::size_t size)
+            {
+                return [data, size]() -> BundleResourceBuffer::ReadFunction
+                {
+                    return [data, size, done = false](char const*& chunk) mutable -> std::size_t
+                    {
+                        if (done || !data)
+                        {
+                            return 0;
+                        }
+                        done = true;
+                        chunk = static_cast<char const*>(data.get());
+                        return size;
+                    };
+                };
+            }
+        } // namespace
+
         class BundleResourceBufferPrivate
         {
           public:
-            BundleResourceBufferPrivate(std::unique_ptr<void, void (*)(void*)> data,
+            BundleResourceBufferPrivate(BundleResourceBuffer::OpenFunction open,
                                         std::size_t size,
-                                        char const* begin,
                                         std::ios_base::openmode mode)
-                : begin(begin)
-                , end(begin + size)
-                , current(begin)
+                : open(std::move(open))
+                , begin(nullptr)
+                , end(nullptr)
+                , current(nullptr)
+                , chunkStart(0)
+                , chunkSize(0)
+                , rawSize(size)
+                , size(size)
+                , sizeKnown(true)
                 , mode(mode)
-                , uncompressedData(reinterpret_cast<unsigned char*>(data.release()), data.get_deleter())
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
                 , pos(0)
 #endif
             {
+#ifdef REMOVE_LAST_NEWLINE_IN_TEXT_MODE
+                // A trailing newline is dropped in text mode, which is only
+                // known once the last chunk has been read.
+                sizeKnown = (mode & std::ios_base::binary) != 0;
+#endif
             }
 
-            char const* const begin;
-            char const* const end;
+            /// Starts reading the data from the beginning.
+            void Rewind();
+
+            /// Reads the chunk following the current one. Returns false if
+            /// there is no more readable data.
+            bool NextChunk();
+
+            /// Moves the read position to the absolute offset \c target,
+            /// reading chunks as needed. Returns false if \c target is out of range.
+            bool Seek(std::size_t target);
+
+            /// Returns the size of the stream data, reading up to the last
+            /// chunk if it depends on a trailing newline.
+            std::size_t Size();
+
+            /// Rethrows the error which stopped reading the data, if any.
+            /// The istream functions catch it and set badbit on the stream.
+            void
+            ThrowIfFailed() const
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            std::size_t
+            Tell() const
+            {
+                return chunkStart + static_cast<std::size_t>(current - begin);
+            }
+
+#ifdef DATA_NEEDS_NEWLINE_CONVERSION
+            /// Newline conversion works on the whole data, so read all
+            /// chunks into one buffer.
+            void MakeContiguous();
+#endif
+
+            BundleResourceBuffer::OpenFunction open;
+            BundleResourceBuffer::ReadFunction read;
+
+            // The readable part of the current chunk, which excludes a
+            // dropped trailing newline.
+            char const* begin;
+            char const* end;
             char const* current;
 
-            const std::ios_base::openmode mode;
+            // The offset and size of the current chunk within the data.
+            std::size_t chunkStart;
+            std::size_t chunkSize;
+
+            const std::size_t rawSize;
+            std::size_t size;
+            bool sizeKnown;
 
-            std::unique_ptr<unsigned char, void (*)(void*)> uncompressedData;
+            // Set if reading a chunk failed, as opposed to the end of the data.
+            std::exception_ptr error;
+
+            const std::ios_base::openmode mode;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
+            std::vector<char> contiguousData;
+
             // records the stream position ignoring CR characters
             std::streambuf::pos_type pos;
 #endif
+
+          private:
+            bool ReadChunk();
         };
 
-        BundleResourceBuffer::BundleResourceBuffer(std::unique_ptr<void, void (*)(void*)> data,
-                                                   std::size_t _size,
-                                                   std::ios_base::openmode mode)
-            : d(nullptr)
+        void
+        BundleResourceBufferPrivate::Rewind()
+        {
+            read = open ? open() : nullptr;
+            error = nullptr;
+            chunkStart = 0;
+            chunkSize = 0;
+            ReadChunk();
+        }
+
+        bool
+        BundleResourceBufferPrivate::NextChunk()
+        {
+            if (chunkSize == 0 || chunkStart + chunkSize >= rawSize)
+            {
+                return false;
+            }
+            chunkStart += chunkSize;
+            return ReadChunk();
+        }
+
+        bool
+        BundleResourceBufferPrivate::ReadChunk()
+        {
+            char const* chunk = nullptr;
+            chunkSize = 0;
+            try
+            {
+                chunkSize = read ? std::min(read(chunk), rawSize - chunkStart) : 0;
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            if (chunkSize == 0 || chunk == nullptr)
+            {
+                if (!error && chunkStart < rawSize)
+                {
+                    error = std::make_exception_ptr(std::runtime_error("Bundle resource data ended unexpectedly"));
+                }
+                chunkSize = 0;
+                begin = end = current = nullptr;
+                size = chunkStart;
+                sizeKnown = true;
+                return false;
+            }
+
+            if (!sizeKnown && chunkStart + chunkSize == rawSize)
+            {
+                sizeKnown = true;
+                if (chunk[chunkSize - 1] == '\n')
+                {
+                    --size;
+                }
+            }
+
+            begin = current = chunk;
+            end = begin + std::min(chunkSize, size - chunkStart);
+            return current != end;
+        }
+
+        bool
+        BundleResourceBufferPrivate::Seek(std::size_t target)
         {
-            assert(_size < static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()));
+            if (target < chunkStart)
+            {
+                Rewind();
+            }
+            // Only read ahead as far as the target, instead of resolving the
+            // size first, so that seeking does not decode the data twice.
+            std::size_t const position = Tell();
+            while (target > chunkStart + static_cast<std::size_t>(end - begin))
+            {
+                if (!NextChunk())
+                {
+                    // out of range, keep the previous position
+                    if (!error)
+                    {
+                        Seek(position);
+                    }
+                    return false;
+                }
+            }
+            current = begin + (target - chunkStart);
+            return true;
+        }
 
-            auto* begin = reinterpret_cast<char*>(data.get());
-            std::size_t size = begin ? _size : 0;
+        std::size_t
+        BundleResourceBufferPrivate::Size()
+        {
+            while (!sizeKnown && NextChunk())
+            {
+            }
+            return size;
+        }
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
-            if (begin != nullptr && !(mode & std::ios_base::binary) && begin[0] == '\r')
+        void
+        BundleResourceBufferPrivate::MakeContiguous()
+        {
+            if (begin == nullptr || chunkSize == rawSize)
             {
-                ++begin;
-                --size;
+                return;
             }
-#endif
 
-#ifdef REMOVE_LAST_NEWLINE_IN_TEXT_MODE
-            if (begin != nullptr && !(mode & std::ios_base::binary) && begin[size - 1] == '\n')
+            contiguousData.assign(begin, end);
+            while (NextChunk())
             {
-                --size;
+                contiguousData.insert(contiguousData.end(), begin, end);
             }
+            read = nullptr;
+            chunkStart = 0;
+            chunkSize = size = contiguousData.size();
+            begin = current = contiguousData.data();
+            end = begin + size;
+        }
 #endif
 
-            d = std::make_unique<BundleResourceBufferPrivate>(std::move(data), size, begin, mode);
+        BundleResourceBuffer::BundleResourceBuffer(std::unique_ptr<void, void (*)(void*)> data,
+                                                   std::size_t size,
+                                                   std::ios_base::openmode mode)
+            : BundleResourceBuffer(OpenContiguous(std::shared_ptr<void const>(data.release(), data.get_deleter()),
+                                                  size),
+                                   size,
+                                   mode)
+        {
+        }
+
+        BundleResourceBuffer::BundleResourceBuffer(OpenFunction open, std::size_t size, std::ios_base::openmode mode)
+            : d(nullptr)
+        {
+            assert(size < static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()));
+
+            d = std::make_unique<BundleResourceBufferPrivate>(std::move(open), size, mode);
+            d->Rewind();
+
+#ifdef DATA_NEEDS_NEWLINE_CONVERSION
+            if (!(mode & std::ios_base::binary))
+            {
+                d->MakeContiguous();
+                if (d->begin != nullptr && d->begin != d->end && d->begin[0] == '\r')
+                {
+                    d->current = ++d->begin;
+                }
+            }
+#endif
         }
 
         BundleResourceBuffer::~BundleResourceBuffer() = default;
@@ -107,8 +318,11 @@ namespace cppmicroservices
         BundleResourceBuffer::int_type
         BundleResourceBuffer::underflow()
         {
-            if (d->current == d->end)
+            if (d->current == d->end && !d->NextChunk())
+            {
+                d->ThrowIfFailed();
                 return traits_type::eof();
+            }
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             char c = *d->current;
@@ -132,8 +346,11 @@ namespace cppmicroservices
         BundleResourceBuffer::int_type
         BundleResourceBuffer::uflow()
         {
-            if (d->current == d->end)
+            if (d->current == d->end && !d->NextChunk())
+            {
+                d->ThrowIfFailed();
                 return traits_type::eof();
+            }
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             char c = *d->current++;
@@ -157,6 +374,19 @@ namespace cppmicroservices
         BundleResourceBuffer::int_type
         BundleResourceBuffer::pbackfail(int_type ch)
         {
+            if (d->current == d->begin && d->chunkStart > 0)
+            {
+                // The previous character is in the previous chunk.
+                auto const position = d->Tell();
+                d->Seek(position - 1);
+                if (ch != traits_type::eof() && ch != traits_type::to_int_type(*d->current))
+                {
+                    d->Seek(position);
+                    return traits_type::eof();
+                }
+                return traits_type::to_int_type(*d->current);
+            }
+
             int backOffset = -1;
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             if (!(d->mode & std::ios_base::binary))
@@ -183,19 +413,25 @@ namespace cppmicroservices
             assert(d->current <= d->end);
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
-            std::streamsize ssize = 0;
-            std::size_t chunkSize = d->end - d->current;
-            for (std::size_t i = 0; i < chunkSize; ++i)
+            if (!(d->mode & std::ios_base::binary))
             {
-                if (d->current[i] != '\r')
+                std::streamsize ssize = 0;
+                std::size_t chunkSize = d->end - d->current;
+                for (std::size_t i = 0; i < chunkSize; ++i)
                 {
-                    ++ssize;
+                    if (d->current[i] != '\r')
+                    {
+                        ++ssize;
+                    }
                 }
+                return ssize;
             }
-            return ssize;
-#else
-            return d->end - d->current;
 #endif
+            if (!d->sizeKnown)
+            {
+                return d->end - d->current;
+            }
+            return static_cast<std::streamsize>(d->size - d->Tell());
         }
 
         std::streambuf::pos_type
@@ -204,26 +440,18 @@ namespace cppmicroservices
                                       std::ios_base::openmode /*which*/)
         {
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
-            std::streambuf::off_type step = 1;
-            if (way == std::ios_base::beg)
-            {
-                d->current = d->begin;
-            }
-            else if (way == std::ios_base::end)
-            {
-                d->current = d->end;
-                step = -1;
-            }
-
             if (!(d->mode & std::ios_base::binary))
             {
+                std::streambuf::off_type step = 1;
                 if (way == std::ios_base::beg)
                 {
+                    d->current = d->begin;
                     d->pos = 0;
                 }
                 else if (way == std::ios_base::end)
                 {
-                    d->current -= 1;
+                    d->current = d->end - 1;
+                    step = -1;
                 }
 
                 std::streambuf::off_type i = 0;
@@ -255,30 +483,32 @@ namespace cppmicroservices
                         ++i;
                     }
                 }
+                return d->pos;
             }
-            else
-            {
-                d->current += off;
-                d->pos = d->current - d->begin;
-            }
-            return d->pos;
-#else
-            if (way == std::ios_base::beg)
+#endif
+            std::streambuf::off_type base = 0;
+            if (way == std::ios_base::cur)
             {
-                d->current = d->begin + off;
-                return off;
+                if (off == 0)
+                {
+                    // tellg
+                    return static_cast<std::streambuf::off_type>(d->Tell());
+                }
+                base = static_cast<std::streambuf::off_type>(d->Tell());
             }
-            else if (way == std::ios_base::cur)
+            else if (way == std::ios_base::end)
             {
-                d->current += off;
-                return d->current - d->begin;
+                base = static_cast<std::streambuf::off_type>(d->Size());
             }
-            else
+
+            std::streambuf::off_type const target = base + off;
+            bool const sought = target >= 0 && d->Seek(static_cast<std::size_t>(target));
+            d->ThrowIfFailed();
+            if (!sought)
             {
-                d->current = d->end + off;
-                return d->current - d->begin;
+                return std::streambuf::pos_type(std::streambuf::off_type(-1));
             }
-#endif
+            return target;
         }
 
         std::streambuf::pos_type
@@ -29,17 +29,54 @@
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/detail/Log.h"
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstdlib>
 #include <cstring>
 #include <exception>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace cppmicroservices
 {
 
+    namespace
+    {
+        // Layout of a zip local file header, see the PKWARE APPNOTE.
+        constexpr uint32_t LocalHeaderSignature = 0x04034b50;
+        constexpr std::size_t LocalHeaderSize = 30;
+        constexpr std::size_t LocalHeaderFileNameLengthOffset = 26;
+        constexpr std::size_t LocalHeaderExtraLengthOffset = 28;
+
+        // Lower cases ASCII letters only, like miniz does for path lookups.
+        std::string
+        ToLowerAscii(std::string str)
+        {
+            for (auto& c : str)
+            {
+                if (c >= 'A' && c <= 'Z')
+                {
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+            }
+            return str;
+        }
+
+        uint32_t
+        ReadLE(unsigned char const* p, std::size_t bytes)
+        {
+            uint32_t value = 0;
+            for (std::size_t i = bytes; i > 0; --i)
+            {
+                value = (value << 8) | p[i - 1];
+            }
+            return value;
+        }
+    } // namespace
+
     BundleResourceContainer::BundleResourceContainer() = default;
 
     BundleResourceContainer::BundleResourceContainer(std::string const& location, ManifestT const& bundleManifest)
@@ -102,11 +139,10 @@ namespace cppmicroservices
     BundleResourceContainer::GetStat(BundleResourceContainer::Stat& stat)
     {
         OpenAndInitializeContainer();
-        int fileIndex
-            = mz_zip_reader_locate_file(const_cast<mz_zip_archive*>(&m_ZipArchive), stat.filePath.c_str(), nullptr, 0);
-        if (fileIndex >= 0)
+        auto iter = m_EntryIndices.find(ToLowerAscii(stat.filePath));
+        if (iter != m_EntryIndices.end())
         {
-            return GetStat(fileIndex, stat);
+            return GetStat(iter->second, stat);
         }
         return false;
     }
@@ -143,47 +179,180 @@ namespace cppmicroservices
     std::unique_ptr<void, void (*)(void*)>
     BundleResourceContainer::GetData(int index)
     {
-        OpenAndInitializeContainer();
-        std::unique_lock<std::mutex> l(m_ZipFileStreamMutex);
+        std::size_t size = 0;
+        if (auto stored = GetStoredData(index, size))
+        {
+            // Stored entries are plain copies out of the mapping and do not
+            // need the stateful miniz reader.
+            void* data = ::malloc(size ? size : 1);
+            if (data != nullptr)
+            {
+                std::memcpy(data, stored.get(), size);
+            }
+            return { data, ::free };
+        }
+
+        auto l = LockFileStream();
         void* data = mz_zip_reader_extract_to_heap(const_cast<mz_zip_archive*>(&m_ZipArchive), index, nullptr, 0);
         return { data, ::free };
     }
 
-    void
-    BundleResourceContainer::GetChildren(std::string const& resourcePath,
-                                         bool relativePaths,
-                                         std::vector<std::string>& names,
-                                         std::vector<uint32_t>& indices) const
+    std::shared_ptr<char const>
+    BundleResourceContainer::GetStoredData(int index, std::size_t& size)
     {
-        auto iter = m_SortedEntries.find(std::make_pair(resourcePath, 0));
-        if (iter == m_SortedEntries.end())
+        OpenAndInitializeContainer();
+        size = 0;
+
+        std::shared_ptr<RawBundleResources> rawData = m_RawData;
+        mz_zip_archive_file_stat zipStat;
+        if (!rawData || index < 0 || !mz_zip_reader_file_stat(&m_ZipArchive, index, &zipStat)
+            || zipStat.m_method != 0 || zipStat.m_is_encrypted || zipStat.m_is_directory
+            || zipStat.m_comp_size != zipStat.m_uncomp_size)
         {
-            return;
+            return nullptr;
         }
 
-        for (++iter; iter != m_SortedEntries.end(); ++iter)
+        auto const* archive = static_cast<unsigned char const*>(rawData->GetData());
+        std::size_t const archiveSize = rawData->GetSize();
+        // Local header offsets are relative to the start of the zip data,
+        // which may be preceded by other bytes (e.g. appended resources).
+        auto const headerOffset = m_ZipArchive.m_archive_file_ofs + zipStat.m_local_header_ofs;
+        if (headerOffset > archiveSize || archiveSize - headerOffset < LocalHeaderSize
+            || ReadLE(archive + headerOffset, 4) != LocalHeaderSignature)
         {
-            if (resourcePath.size() > iter->first.size())
+            return nullptr;
+        }
+
+        auto const dataOffset = headerOffset + LocalHeaderSize
+                                + ReadLE(archive + headerOffset + LocalHeaderFileNameLengthOffset, 2)
+                                + ReadLE(archive + headerOffset + LocalHeaderExtraLengthOffset, 2);
+        if (dataOffset > archiveSize || archiveSize - dataOffset < zipStat.m_uncomp_size)
+        {
+            return nullptr;
+        }
+
+        size = static_cast<std::size_t>(zipStat.m_uncomp_size);
+        return { rawData, reinterpret_cast<char const*>(archive + dataOffset) };
+    }
+
+    std::function<std::size_t(char const*&)>
+    BundleResourceContainer::ReadData(int index)
+    {
+        std::size_t size = 0;
+        std::shared_ptr<void const> data = GetStoredData(index, size);
+
+        Stat stat;
+        if (!data && GetStat(index, stat) && !stat.isDir
+            && static_cast<std::size_t>(stat.uncompressedSize) > ReadChunkSize)
+        {
+            struct Inflater
             {
-                break;
+                ~Inflater()
+                {
+                    if (state != nullptr)
+                    {
+                        mz_zip_reader_extract_iter_free(state);
+                    }
+                }
+
+                /// Frees the iterator state. Returns false if the data did not
+                /// decompress to the expected size or its CRC does not match.
+                bool
+                Finish()
+                {
+                    auto const ok = mz_zip_reader_extract_iter_free(state);
+                    state = nullptr;
+                    return ok != MZ_FALSE;
+                }
+
+                mz_zip_reader_extract_iter_state* state = nullptr;
+                std::vector<char> chunk;
+            };
+
+            auto inflater = std::make_shared<Inflater>();
+            {
+                auto l = LockFileStream();
+                inflater->state = mz_zip_reader_extract_iter_new(&m_ZipArchive, index, 0);
             }
-            if (iter->first.compare(0, resourcePath.size(), resourcePath) == 0)
+            if (inflater->state != nullptr)
             {
-                std::size_t pos = iter->first.find_first_of('/', resourcePath.size());
-                if (pos == std::string::npos || pos == iter->first.size() - 1)
+                inflater->chunk.resize(ReadChunkSize);
+                // Keep this container, and hence the zip archive, alive while reading.
+                return [self = shared_from_this(), inflater, path = stat.filePath](char const*& chunk) -> std::size_t
                 {
-                    if (relativePaths)
+                    auto l = self->LockFileStream();
+                    auto* state = inflater->state;
+                    if (state == nullptr)
+                    {
+                        return 0;
+                    }
+
+                    chunk = inflater->chunk.data();
+                    auto const read = mz_zip_reader_extract_iter_read(state, inflater->chunk.data(), inflater->chunk.size());
+                    bool ok = state->status >= TINFL_STATUS_DONE;
+                    if (ok && state->out_buf_ofs == state->file_stat.m_uncomp_size)
                     {
-                        names.push_back(iter->first.substr(resourcePath.size()));
+                        // All data has been returned. Drive the inflater to the end of
+                        // the deflate stream, so that freeing it verifies size and CRC.
+                        char extra = 0;
+                        ok = mz_zip_reader_extract_iter_read(state, &extra, 1) == 0;
+                        ok = inflater->Finish() && ok;
                     }
-                    else
+                    else if (ok && read == 0)
                     {
-                        names.push_back(iter->first);
+                        // The deflate stream ended before all data was returned.
+                        ok = false;
                     }
-                    indices.push_back(iter->second);
-                }
+
+                    if (!ok)
+                    {
+                        if (inflater->state != nullptr)
+                        {
+                            inflater->Finish();
+                        }
+                        throw std::runtime_error("Decompressing bundle resource " + path + " failed: "
+                                                 + mz_zip_get_error_string(mz_zip_get_last_error(&self->m_ZipArchive)));
+                    }
+                    return read;
+                };
             }
         }
+
+        if (!data)
+        {
+            auto extracted = GetData(index);
+            size = extracted ? static_cast<std::size_t>(stat.uncompressedSize) : 0;
+            data = std::shared_ptr<void const>(extracted.release(), extracted.get_deleter());
+        }
+        return [data, size, done = false](char const*& chunk) mutable -> std::size_t
+        {
+            if (done)
+            {
+                return 0;
+            }
+            done = true;
+            chunk = static_cast<char const*>(data.get());
+            return size;
+        };
+    }
+
+    void
+    BundleResourceContainer::GetChildren(std::string const& resourcePath,
+                                         bool relativePaths,
+                                         std::vector<std::string>& names,
+                                         std::vector<uint32_t>& indices) const
+    {
+        auto iter = m_DirectoryIds.find(resourcePath);
+        if (iter == m_DirectoryIds.end())
+        {
+            return;
+        }
+
+        for (auto const& child : m_DirectoryChildren[iter->second])
+        {
+            names.push_back(relativePaths ? child.name : resourcePath + child.name);
+            indices.push_back(child.index);
+        }
     }
 
     void
@@ -193,22 +362,45 @@ namespace cppmicroservices
                                        bool recurse,
                                        std::vector<BundleResource>& resources) const
     {
-        std::vector<std::string> names;
-        std::vector<uint32_t> indices;
-
         OpenAndInitializeContainer();
 
-        this->GetChildren(path, true, names, indices);
+        auto iter = m_DirectoryIds.find(path);
+        if (iter == m_DirectoryIds.end())
+        {
+            return;
+        }
+
+        // Split the pattern once instead of for every matched name.
+        std::vector<std::string> patternTokens;
+        std::stringstream ss(filePattern);
+        std::string tok;
+        while (std::getline(ss, tok, '*'))
+        {
+            if (!tok.empty())
+            {
+                patternTokens.push_back(tok);
+            }
+        }
+
+        FindNodes(archive, iter->second, patternTokens, recurse, resources);
+    }
 
-        for (std::size_t i = 0, s = names.size(); i < s; ++i)
+    void
+    BundleResourceContainer::FindNodes(std::shared_ptr<BundleArchive const> const& archive,
+                                       std::size_t directory,
+                                       std::vector<std::string> const& patternTokens,
+                                       bool recurse,
+                                       std::vector<BundleResource>& resources) const
+    {
+        for (auto const& child : m_DirectoryChildren[directory])
         {
-            if (*names[i].rbegin() == '/' && recurse)
+            if (child.directory != NoDirectory && recurse)
             {
-                this->FindNodes(archive, path + names[i], filePattern, recurse, resources);
+                FindNodes(archive, child.directory, patternTokens, recurse, resources);
             }
-            if (this->Matches(names[i], filePattern))
+            if (Matches(child.name, patternTokens))
             {
-                resources.push_back(BundleResource(indices[i], archive));
+                resources.push_back(BundleResource(child.index, archive));
             }
         }
     }
@@ -229,11 +421,15 @@ namespace cppmicroservices
         {
         }
 
-        if (!rawBundleResourceData || !rawBundleResourceData->GetData()
-            || !mz_zip_reader_init_mem(&m_ZipArchive,
-                                       rawBundleResourceData->GetData(),
-                                       rawBundleResourceData->GetSize(),
-                                       0))
+        if (rawBundleResourceData && rawBundleResourceData->GetData()
+            && mz_zip_reader_init_mem(&m_ZipArchive,
+                                      rawBundleResourceData->GetData(),
+                                      rawBundleResourceData->GetSize(),
+                                      0))
+        {
+            m_RawData = std::move(rawBundleResourceData);
+        }
+        else
         {
             if (!mz_zip_reader_init_file(&m_ZipArchive, m_Location.c_str(), 0))
             {
@@ -243,38 +439,86 @@ namespace cppmicroservices
     }
 
     void
-    BundleResourceContainer::InitSortedEntries() const
+    BundleResourceContainer::InitEntryIndex() const
     {
+        if (!m_EntryIndices.empty())
+        {
+            // The container was closed and opened again, the entries did not change.
+            return;
+        }
+
+        std::vector<std::pair<std::string, int>> entries;
         mz_uint numFiles = mz_zip_reader_get_num_files(const_cast<mz_zip_archive*>(&m_ZipArchive));
+        entries.reserve(numFiles);
         for (mz_uint fileIndex = 0; fileIndex < numFiles; ++fileIndex)
         {
             char fileName[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
             if (mz_zip_reader_get_filename(&m_ZipArchive, fileIndex, fileName, MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE))
             {
                 std::string strFileName = fileName;
-                m_SortedEntries.insert(std::make_pair(strFileName, fileIndex));
                 std::size_t pos = strFileName.find_first_of('/');
                 if (pos != std::string::npos)
                 {
                     m_SortedToplevelDirs.insert(strFileName.substr(0, pos));
                 }
+                m_EntryIndices.emplace(ToLowerAscii(strFileName), fileIndex);
+                entries.emplace_back(std::move(strFileName), fileIndex);
             }
         }
-    }
 
-    bool
-    BundleResourceContainer::Matches(std::string const& name, std::string const& filePattern) const
-    {
-        // short-cut
-        if (filePattern == "*")
+        // Number the directory entries. Duplicate entries are skipped, the
+        // first one wins.
+        std::unordered_set<std::string> seen;
+        for (auto& entry : entries)
         {
-            return true;
+            if (entry.first.empty() || !seen.insert(entry.first).second)
+            {
+                entry.second = -1;
+            }
+            else if (entry.first.back() == '/')
+            {
+                m_DirectoryIds.emplace(entry.first, m_DirectoryChildren.size());
+                m_DirectoryChildren.emplace_back();
+            }
         }
 
-        std::stringstream ss(filePattern);
-        std::string tok;
+        // Add each entry to the children of its parent directory entry.
+        for (auto const& entry : entries)
+        {
+            auto const& name = entry.first;
+            bool const isDir = !name.empty() && name.back() == '/';
+            if (entry.second < 0 || name.size() < 2)
+            {
+                continue;
+            }
+
+            std::size_t pos = name.find_last_of('/', name.size() - (isDir ? 2 : 1));
+            if (pos == std::string::npos)
+            {
+                continue;
+            }
+
+            auto parent = m_DirectoryIds.find(name.substr(0, pos + 1));
+            if (parent != m_DirectoryIds.end())
+            {
+                m_DirectoryChildren[parent->second].push_back(
+                    ChildEntry { name.substr(pos + 1), entry.second, isDir ? m_DirectoryIds[name] : NoDirectory });
+            }
+        }
+
+        for (auto& children : m_DirectoryChildren)
+        {
+            std::sort(children.begin(),
+                      children.end(),
+                      [](ChildEntry const& c1, ChildEntry const& c2) { return c1.name < c2.name; });
+        }
+    }
+
+    bool
+    BundleResourceContainer::Matches(std::string const& name, std::vector<std::string> const& patternTokens)
+    {
         std::size_t pos = 0;
-        while (std::getline(ss, tok, '*'))
+        for (auto const& tok : patternTokens)
         {
             std::size_t index = name.find(tok, pos);
             if (index == std::string::npos)
@@ -289,22 +533,39 @@ namespace cppmicroservices
     void
     BundleResourceContainer::OpenAndInitializeContainer() const
     {
+        if (m_IsContainerOpen.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
         std::lock_guard<std::mutex> lock(m_ZipFileMutex);
         if (!m_IsContainerOpen)
         {
             InitMiniz();
 
-            InitSortedEntries();
+            InitEntryIndex();
             if (m_SortedToplevelDirs.empty())
             {
                 // This is not a file containing a valid bundle
                 // so make sure we clean up and close the file handle.
                 mz_zip_reader_end(&m_ZipArchive);
                 m_ObjFile.reset();
+                m_RawData.reset();
                 throw std::runtime_error("Invalid zip archive layout for bundle at " + m_Location);
             }
-            m_IsContainerOpen = true;
+            m_IsContainerOpen.store(true, std::memory_order_release);
+        }
+    }
+
+    std::unique_lock<std::mutex>
+    BundleResourceContainer::LockFileStream() const
+    {
+        std::unique_lock<std::mutex> lock(m_ZipFileStreamMutex, std::defer_lock);
+        if (mz_zip_get_type(&m_ZipArchive) != MZ_ZIP_TYPE_MEMORY)
+        {
+            lock.lock();
         }
+        return lock;
     }
 
     void
@@ -315,6 +576,7 @@ namespace cppmicroservices
         {
             mz_zip_reader_end(&m_ZipArchive);
             m_ObjFile.reset();
+            m_RawData.reset();
             m_IsContainerOpen = false;
         }
     }
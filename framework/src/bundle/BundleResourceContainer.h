@@ -28,11 +28,14 @@
 
 #include "miniz.h"
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cppmicroservices
@@ -73,6 +76,21 @@ namespace cppmicroservices
 
         std::unique_ptr<void, void (*)(void*)> GetData(int index);
 
+        /// Returns a pointer to the bytes of a stored (uncompressed) entry
+        /// inside the memory mapped resource zip file, or nullptr if the
+        /// entry is compressed, a directory, or the zip file is not mapped.
+        /// The returned pointer keeps the mapping alive.
+        std::shared_ptr<char const> GetStoredData(int index, std::size_t& size);
+
+        /// Compressed entries larger than this are decompressed incrementally
+        /// in chunks of this size by ReadData.
+        static constexpr std::size_t ReadChunkSize = 64 * 1024;
+
+        /// Returns a function which reads the uncompressed data of an entry
+        /// chunk by chunk, see detail::BundleResourceBuffer::ReadFunction.
+        /// Stored and small entries are returned as a single chunk.
+        std::function<std::size_t(char const*&)> ReadData(int index);
+
         void GetChildren(std::string const& resourcePath,
                          bool relativePaths,
                          std::vector<std::string>& names,
@@ -91,20 +109,28 @@ namespace cppmicroservices
         void CloseContainer();
 
       private:
-        using NameIndexPair = std::pair<std::string, int>;
-
-        struct PairComp
+        /// A child of a directory entry in the zip file.
+        struct ChildEntry
         {
-            inline bool
-            operator()(NameIndexPair const& p1, NameIndexPair const& p2) const
-            {
-                return p1.first < p2.first;
-            }
+            // The last path component, with a trailing '/' for directories
+            std::string name;
+            int index;
+            // The directory id of directory entries, NoDirectory otherwise
+            std::size_t directory;
         };
 
-        void InitSortedEntries() const;
+        static constexpr std::size_t NoDirectory = static_cast<std::size_t>(-1);
+
+        /// Builds the path and directory indices of the zip file entries.
+        void InitEntryIndex() const;
 
-        bool Matches(std::string const& name, std::string const& filePattern) const;
+        void FindNodes(std::shared_ptr<BundleArchive const> const& archive,
+                       std::size_t directory,
+                       std::vector<std::string> const& patternTokens,
+                       bool recurse,
+                       std::vector<BundleResource>& resources) const;
+
+        static bool Matches(std::string const& name, std::vector<std::string> const& patternTokens);
 
         /// Initialize miniz with the resource zip file information.
         /// throws std::runtime_error if the underlying zip file cannot be opened or read.
@@ -115,22 +141,35 @@ namespace cppmicroservices
         /// Throws std::runtime_error if the underlying zip file cannot be opened.
         void OpenAndInitializeContainer() const;
 
+        /// Locks m_ZipFileStreamMutex if miniz reads the zip file through a
+        /// file stream. Archives in memory have no shared read state and are
+        /// extracted concurrently.
+        std::unique_lock<std::mutex> LockFileStream() const;
+
         const std::string m_Location;
         mutable mz_zip_archive m_ZipArchive;
         mutable std::unique_ptr<BundleObjFile> m_ObjFile;
-
-        mutable std::set<NameIndexPair, PairComp> m_SortedEntries;
+        // The memory mapped zip file, if miniz reads from memory.
+        mutable std::shared_ptr<RawBundleResources> m_RawData;
+
+        // Maps the lower case path of each entry to its index. Like miniz,
+        // path lookups are case-insensitive.
+        mutable std::unordered_map<std::string, int> m_EntryIndices;
+        // Maps the path of each directory entry to its directory id.
+        mutable std::unordered_map<std::string, std::size_t> m_DirectoryIds;
+        // The children of each directory, sorted by name.
+        mutable std::vector<std::vector<ChildEntry>> m_DirectoryChildren;
         mutable std::set<std::string> m_SortedToplevelDirs;
 
         // This is used to synchronize miniz file stream API calls.
         // Working with file streams is stateful (e.g. current read position)
-        // and hence not thread-safe.
+        // and hence not thread-safe. See LockFileStream().
         mutable std::mutex m_ZipFileStreamMutex;
 
         // Synchronize opening/closing the underlying zip file. Only one thread
         // should open the underlying zip file.
         mutable std::mutex m_ZipFileMutex;
-        mutable bool m_IsContainerOpen;
+        mutable std::atomic<bool> m_IsContainerOpen;
     };
 } // namespace cppmicroservices
 
@@ -0,0 +1,268 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundleStartScheduler.h"
+
+#include "cppmicroservices/Constants.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace cppmicroservices
+{
+
+    namespace
+    {
+
+        std::vector<std::string>
+        GetStartDependencies(Bundle const& bundle)
+        {
+            std::vector<std::string> names;
+            auto const& headers = bundle.GetHeaders();
+            auto iter = headers.find(Constants::BUNDLE_STARTDEPENDENCIES);
+            if (iter == headers.end())
+            {
+                return names;
+            }
+
+            auto const& value = iter->second;
+            if (value.Type() == typeid(std::string))
+            {
+                names.push_back(ref_any_cast<std::string>(value));
+                return names;
+            }
+            if (value.Type() == typeid(std::vector<Any>))
+            {
+                auto const& values = ref_any_cast<std::vector<Any>>(value);
+                if (std::all_of(values.begin(),
+                                values.end(),
+                                [](Any const& name) { return name.Type() == typeid(std::string); }))
+                {
+                    for (auto const& name : values)
+                    {
+                        names.push_back(ref_any_cast<std::string>(name));
+                    }
+                    return names;
+                }
+            }
+            throw std::invalid_argument("The " + Constants::BUNDLE_STARTDEPENDENCIES + " header of bundle "
+                                        + bundle.GetSymbolicName() + " (location=" + bundle.GetLocation()
+                                        + ") must be a string or an array of strings");
+        }
+
+    } // namespace
+
+    BundleStartScheduler::BundleStartScheduler(std::vector<Bundle> const& bundlesToStart)
+    {
+        std::unordered_map<Bundle, std::size_t> indices;
+        for (auto const& bundle : bundlesToStart)
+        {
+            auto p = indices.emplace(bundle, bundles.size());
+            if (p.second)
+            {
+                bundles.push_back(bundle);
+            }
+            positions.push_back(p.first->second);
+        }
+
+        std::unordered_map<std::string, std::vector<std::size_t>> bySymbolicName;
+        for (std::size_t i = 0; i < bundles.size(); ++i)
+        {
+            bySymbolicName[bundles[i].GetSymbolicName()].push_back(i);
+        }
+
+        dependents.resize(bundles.size());
+        dependencyCounts.resize(bundles.size());
+        for (std::size_t i = 0; i < bundles.size(); ++i)
+        {
+            for (auto const& name : GetStartDependencies(bundles[i]))
+            {
+                auto iter = bySymbolicName.find(name);
+                if (iter == bySymbolicName.end())
+                {
+                    continue;
+                }
+                for (auto dependency : iter->second)
+                {
+                    if (dependency != i)
+                    {
+                        dependents[dependency].push_back(i);
+                        ++dependencyCounts[i];
+                    }
+                }
+            }
+        }
+
+        // Reject cycles up front, they would leave their bundles waiting forever.
+        auto counts = dependencyCounts;
+        std::vector<std::size_t> ready;
+        for (std::size_t i = 0; i < bundles.size(); ++i)
+        {
+            if (counts[i] == 0)
+            {
+                ready.push_back(i);
+            }
+        }
+        std::size_t ordered = 0;
+        while (!ready.empty())
+        {
+            auto i = ready.back();
+            ready.pop_back();
+            ++ordered;
+            for (auto dependent : dependents[i])
+            {
+                if (--counts[dependent] == 0)
+                {
+                    ready.push_back(dependent);
+                }
+            }
+        }
+        if (ordered != bundles.size())
+        {
+            std::string cycle;
+            for (std::size_t i = 0; i < bundles.size(); ++i)
+            {
+                if (counts[i] != 0)
+                {
+                    cycle += (cycle.empty() ? "" : ", ") + bundles[i].GetSymbolicName();
+                }
+            }
+            throw std::invalid_argument("Cyclic start dependencies between the bundles " + cycle);
+        }
+    }
+
+    std::vector<std::exception_ptr>
+    BundleStartScheduler::Run(uint32_t options)
+    {
+        return Run([options](Bundle& bundle) { bundle.Start(options); });
+    }
+
+    std::vector<std::exception_ptr>
+    BundleStartScheduler::Run(std::function<void(Bundle&)> const& start)
+    {
+        return Run(start, dependents, dependencyCounts);
+    }
+
+    std::vector<std::exception_ptr>
+    BundleStartScheduler::RunReverse(std::function<void(Bundle&)> const& stop)
+    {
+        std::vector<std::vector<std::size_t>> dependencies(bundles.size());
+        std::vector<std::size_t> dependentCounts(bundles.size());
+        for (std::size_t i = 0; i < bundles.size(); ++i)
+        {
+            for (auto dependent : dependents[i])
+            {
+                dependencies[dependent].push_back(i);
+            }
+            dependentCounts[i] = dependents[i].size();
+        }
+        return Run(stop, dependencies, std::move(dependentCounts));
+    }
+
+    std::vector<std::exception_ptr>
+    BundleStartScheduler::Run(std::function<void(Bundle&)> const& func,
+                              std::vector<std::vector<std::size_t>> const& successors,
+                              std::vector<std::size_t> pending)
+    {
+        std::vector<std::exception_ptr> errors(bundles.size());
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::size_t> ready;
+        std::size_t finished = 0;
+        for (std::size_t i = 0; i < bundles.size(); ++i)
+        {
+            if (pending[i] == 0)
+            {
+                ready.push_back(i);
+            }
+        }
+
+        auto work = [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                cv.wait(lock, [&] { return !ready.empty() || finished == bundles.size(); });
+                if (ready.empty())
+                {
+                    return;
+                }
+                auto const i = ready.front();
+                ready.pop_front();
+                lock.unlock();
+
+                try
+                {
+                    func(bundles[i]);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+
+                lock.lock();
+                ++finished;
+                for (auto successor : successors[i])
+                {
+                    if (--pending[successor] == 0)
+                    {
+                        ready.push_back(successor);
+                    }
+                }
+                cv.notify_all();
+            }
+        };
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+        std::size_t const workers
+            = std::min<std::size_t>(bundles.size(), std::max(1u, std::thread::hardware_concurrency()));
+#else
+        std::size_t const workers = 1;
+#endif
+        std::vector<std::future<void>> helpers;
+        for (std::size_t w = 1; w < workers; ++w)
+        {
+            helpers.push_back(std::async(std::launch::async, work));
+        }
+        work();
+        for (auto& helper : helpers)
+        {
+            helper.get();
+        }
+
+        std::vector<std::exception_ptr> result;
+        result.reserve(positions.size());
+        for (auto position : positions)
+        {
+            result.push_back(errors[position]);
+        }
+        return result;
+    }
+} // namespace cppmicroservices
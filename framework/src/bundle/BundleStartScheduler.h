@@ -0,0 +1,96 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLESTARTSCHEDULER_H
+#define CPPMICROSERVICES_BUNDLESTARTSCHEDULER_H
+
+#include "cppmicroservices/Bundle.h"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    /**
+     * Starts a set of bundles on a pool of worker threads. A bundle is started
+     * after the bundles of the set named in its bundle.start_dependencies
+     * manifest header have finished starting. Stopping the set follows the
+     * same dependencies in reverse.
+     */
+    class BundleStartScheduler
+    {
+      public:
+        /**
+         * Build the start dependency graph of a set of bundles. Repeated bundles
+         * are started once.
+         *
+         * @throws std::invalid_argument If the start dependencies are cyclic or
+         *         a bundle.start_dependencies header is malformed.
+         */
+        explicit BundleStartScheduler(std::vector<Bundle> const& bundles);
+
+        /**
+         * Start all bundles and wait until all of them finished starting.
+         *
+         * @param options The options passed to Bundle::Start(uint32_t).
+         * @return For each bundle passed to the constructor, the exception thrown
+         *         when starting it, or nullptr.
+         */
+        std::vector<std::exception_ptr> Run(uint32_t options);
+
+        /**
+         * Start all bundles by calling \c start for each of them and wait until
+         * all of them finished starting.
+         *
+         * @return For each bundle passed to the constructor, the exception thrown
+         *         by \c start, or nullptr.
+         */
+        std::vector<std::exception_ptr> Run(std::function<void(Bundle&)> const& start);
+
+        /**
+         * Stop all bundles by calling \c stop for each of them and wait until
+         * all of them finished stopping. The start dependencies are followed in
+         * reverse: a bundle is stopped after the bundles of the set depending
+         * on it have finished stopping.
+         *
+         * @return For each bundle passed to the constructor, the exception thrown
+         *         by \c stop, or nullptr.
+         */
+        std::vector<std::exception_ptr> RunReverse(std::function<void(Bundle&)> const& stop);
+
+      private:
+        std::vector<std::exception_ptr> Run(std::function<void(Bundle&)> const& func,
+                                            std::vector<std::vector<std::size_t>> const& successors,
+                                            std::vector<std::size_t> pending);
+
+        std::vector<Bundle> bundles;
+        /// For each bundle passed to the constructor, its index in bundles.
+        std::vector<std::size_t> positions;
+        std::vector<std::vector<std::size_t>> dependents;
+        std::vector<std::size_t> dependencyCounts;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_BUNDLESTARTSCHEDULER_H
@@ -79,6 +79,17 @@ namespace cppmicroservices
          */
         virtual void Close() = 0;
 
+        /**
+         * Whether the bundle archives outlive this framework instance. A persistent
+         * storage needs to know the manifests read from bundle files, see
+         * BundleArchive::SetManifest.
+         */
+        virtual bool
+        IsPersistent() const
+        {
+            return false;
+        }
+
       private:
         friend struct BundleArchive;
         /**
@@ -22,46 +22,581 @@
 
 #include "BundleStorageFile.h"
 
+#include "cppmicroservices/util/FileSystem.h"
+
 #include "BundleArchive.h"
+#include "BundleResourceContainer.h"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
 
 namespace cppmicroservices
 {
 
-    BundleStorageFile::BundleStorageFile() : BundleStorage() { throw std::logic_error("not implemented"); }
+    namespace
+    {
+
+        std::uint32_t const CacheMagic = 0x43534D55; // "UMSC"
+        std::uint32_t const CacheFormatVersion = 2;
+
+        enum class ValueTag : std::uint8_t
+        {
+            String = 0,
+            Bool = 1,
+            Int = 2,
+            Double = 3,
+            Map = 4,
+            Vector = 5,
+            OrderedMap = 6
+        };
+
+        /**
+         * Appends values in host byte order to a buffer. The cache is private to the
+         * framework storage area of one machine, so it is not meant to be portable.
+         */
+        class CacheWriter
+        {
+          public:
+            template <typename T>
+            void
+            WriteValue(T value)
+            {
+                static_assert(std::is_arithmetic_v<T>, "only arithmetic values can be written");
+                buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+            }
+
+            void
+            WriteString(std::string const& str)
+            {
+                WriteValue(static_cast<std::uint32_t>(str.size()));
+                buffer.append(str);
+            }
+
+            void WriteAny(Any const& value);
+
+            void
+            WriteMap(AnyMap const& map)
+            {
+                WriteValue(static_cast<std::uint8_t>(map.GetType()));
+                WriteValue(static_cast<std::uint32_t>(map.size()));
+                for (auto const& entry : map)
+                {
+                    WriteString(entry.first);
+                    WriteAny(entry.second);
+                }
+            }
+
+            std::string&
+            Buffer()
+            {
+                return buffer;
+            }
+
+          private:
+            std::string buffer;
+        };
+
+        void
+        CacheWriter::WriteAny(Any const& value)
+        {
+            auto const& type = value.Type();
+            if (type == typeid(std::string))
+            {
+                WriteValue(static_cast<std::uint8_t>(ValueTag::String));
+                WriteString(ref_any_cast<std::string>(value));
+            }
+            else if (type == typeid(bool))
+            {
+                WriteValue(static_cast<std::uint8_t>(ValueTag::Bool));
+                WriteValue(static_cast<std::uint8_t>(ref_any_cast<bool>(value) ? 1 : 0));
+            }
+            else if (type == typeid(int))
+            {
+                WriteValue(static_cast<std::uint8_t>(ValueTag::Int));
+                WriteValue(static_cast<std::int32_t>(ref_any_cast<int>(value)));
+            }
+            else if (type == typeid(double))
+            {
+                WriteValue(static_cast<std::uint8_t>(ValueTag::Double));
+                WriteValue(ref_any_cast<double>(value));
+            }
+            else if (type == typeid(AnyMap))
+            {
+                WriteValue(static_cast<std::uint8_t>(ValueTag::Map));
+                WriteMap(ref_any_cast<AnyMap>(value));
+            }
+            else if (type == typeid(std::vector<Any>))
+            {
+                auto const& vec = ref_any_cast<std::vector<Any>>(value);
+                WriteValue(static_cast<std::uint8_t>(ValueTag::Vector));
+                WriteValue(static_cast<std::uint32_t>(vec.size()));
+                for (auto const& element : vec)
+                {
+                    WriteAny(element);
+                }
+            }
+            else if (type == typeid(std::map<std::string, Any>))
+            {
+                auto const& map = ref_any_cast<std::map<std::string, Any>>(value);
+                WriteValue(static_cast<std::uint8_t>(ValueTag::OrderedMap));
+                WriteValue(static_cast<std::uint32_t>(map.size()));
+                for (auto const& entry : map)
+                {
+                    WriteString(entry.first);
+                    WriteAny(entry.second);
+                }
+            }
+            else
+            {
+                throw std::invalid_argument(std::string("Cannot cache a manifest value of type ") + type.name());
+            }
+        }
+
+        /**
+         * Reads the values written by CacheWriter, throwing std::runtime_error if
+         * the buffer ends prematurely or contains an unknown value.
+         */
+        class CacheReader
+        {
+          public:
+            explicit CacheReader(std::string const& data) : pos(data.data()), end(data.data() + data.size()) {}
+
+            bool
+            AtEnd() const
+            {
+                return pos == end;
+            }
+
+            template <typename T>
+            T
+            ReadValue()
+            {
+                static_assert(std::is_arithmetic_v<T>, "only arithmetic values can be read");
+                Require(sizeof(T));
+                T value;
+                std::memcpy(&value, pos, sizeof(T));
+                pos += sizeof(T);
+                return value;
+            }
+
+            /// Reads an element count, each element taking at least one byte.
+            std::size_t
+            ReadCount()
+            {
+                auto const count = ReadValue<std::uint32_t>();
+                Require(count);
+                return count;
+            }
+
+            std::string
+            ReadString()
+            {
+                auto const size = ReadValue<std::uint32_t>();
+                Require(size);
+                std::string str(pos, size);
+                pos += size;
+                return str;
+            }
+
+            Any ReadAny();
+
+            AnyMap
+            ReadMap()
+            {
+                auto const type = ReadValue<std::uint8_t>();
+                if (type > AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+                {
+                    throw std::runtime_error("Invalid map type in bundle cache");
+                }
+                auto const count = ReadCount();
+                if (type == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+                {
+                    // Manifests use this map type, build it with its final bucket count.
+                    AnyMap::unordered_any_cimap map;
+                    map.reserve(count);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        auto key = ReadString();
+                        map.emplace(std::move(key), ReadAny());
+                    }
+                    return AnyMap(std::move(map));
+                }
+
+                AnyMap map(static_cast<AnyMap::map_type>(type));
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto key = ReadString();
+                    map.emplace(std::move(key), ReadAny());
+                }
+                return map;
+            }
+
+          private:
+            void
+            Require(std::size_t size) const
+            {
+                if (static_cast<std::size_t>(end - pos) < size)
+                {
+                    throw std::runtime_error("Truncated bundle cache");
+                }
+            }
+
+            char const* pos;
+            char const* const end;
+        };
+
+        Any
+        CacheReader::ReadAny()
+        {
+            switch (static_cast<ValueTag>(ReadValue<std::uint8_t>()))
+            {
+                case ValueTag::String:
+                    return Any(ReadString());
+                case ValueTag::Bool:
+                    return Any(ReadValue<std::uint8_t>() != 0);
+                case ValueTag::Int:
+                    return Any(static_cast<int>(ReadValue<std::int32_t>()));
+                case ValueTag::Double:
+                    return Any(ReadValue<double>());
+                case ValueTag::Map:
+                    return Any(ReadMap());
+                case ValueTag::Vector:
+                {
+                    Any any = std::vector<Any>();
+                    auto& vec = ref_any_cast<std::vector<Any>>(any);
+                    auto const count = ReadCount();
+                    vec.reserve(count);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        vec.emplace_back(ReadAny());
+                    }
+                    return any;
+                }
+                case ValueTag::OrderedMap:
+                {
+                    Any any = std::map<std::string, Any>();
+                    auto& map = ref_any_cast<std::map<std::string, Any>>(any);
+                    auto const count = ReadCount();
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        auto key = ReadString();
+                        map.emplace(std::move(key), ReadAny());
+                    }
+                    return any;
+                }
+            }
+            throw std::runtime_error("Invalid value tag in bundle cache");
+        }
+
+    } // namespace
+
+    BundleStorageFile::BundleStorageFile(std::string const& storagePath,
+                                         bool cleanStorage,
+                                         std::shared_ptr<detail::LogSink> sink)
+        : BundleStorage()
+        , cacheFile(storagePath + util::DIR_SEP + "archives.cache")
+        , sink(std::move(sink))
+        , nextFreeId(1)
+    {
+        if (cleanStorage)
+        {
+            std::remove(cacheFile.c_str());
+            return;
+        }
+
+        std::ifstream in(cacheFile, std::ios::binary);
+        if (!in)
+        {
+            return;
+        }
+        std::string const data { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+        try
+        {
+            LoadArchives_unlocked(data);
+        }
+        catch (std::exception const&)
+        {
+            // A corrupt or outdated cache is discarded, its bundles have to be installed again.
+            archives.v.clear();
+            archives.fingerprints.clear();
+            nextFreeId = 1;
+        }
+    }
+
+    void
+    BundleStorageFile::LoadArchives_unlocked(std::string const& data)
+    {
+        CacheReader reader(data);
+        if (reader.ReadValue<std::uint32_t>() != CacheMagic
+            || reader.ReadValue<std::uint32_t>() != CacheFormatVersion
+            || reader.ReadString() != CppMicroServices_VERSION_STR)
+        {
+            throw std::runtime_error("Incompatible bundle cache");
+        }
+        nextFreeId = static_cast<long>(reader.ReadValue<std::int64_t>());
+
+        auto const locationCount = reader.ReadCount();
+        for (std::size_t i = 0; i < locationCount; ++i)
+        {
+            auto location = reader.ReadString();
+            Fingerprint fingerprint;
+            fingerprint.size = reader.ReadValue<std::uint64_t>();
+            fingerprint.modifiedTime = reader.ReadValue<std::int64_t>();
+            fingerprint.fileId = reader.ReadValue<std::uint64_t>();
+
+            // The resource container only needs the keys of the injected manifests. Listing
+            // all top level entries lets bundles which are not cached be installed from it later.
+            AnyMap topLevelEntries(AnyMap::ORDERED_MAP);
+            auto const entryCount = reader.ReadCount();
+            for (std::size_t j = 0; j < entryCount; ++j)
+            {
+                topLevelEntries.emplace(reader.ReadString(), Any());
+            }
+
+            struct CachedArchive
+            {
+                long id;
+                std::string prefix;
+                int32_t autostartSetting;
+                AnyMap manifest;
+            };
+            std::vector<CachedArchive> cachedArchives;
+            auto const archiveCount = reader.ReadCount();
+            for (std::size_t j = 0; j < archiveCount; ++j)
+            {
+                auto const id = static_cast<long>(reader.ReadValue<std::int64_t>());
+                auto prefix = reader.ReadString();
+                auto const autostartSetting = reader.ReadValue<std::int32_t>();
+                cachedArchives.push_back({ id, std::move(prefix), autostartSetting, reader.ReadMap() });
+            }
+
+            Fingerprint current;
+            try
+            {
+                if (!util::GetFileStat(location, current.size, current.modifiedTime, current.fileId)
+                    || current.size != fingerprint.size || current.modifiedTime != fingerprint.modifiedTime
+                    || current.fileId != fingerprint.fileId)
+                {
+                    continue;
+                }
+            }
+            catch (std::exception const&)
+            {
+                continue;
+            }
+
+            auto resCont = std::make_shared<BundleResourceContainer>(location, topLevelEntries);
+            for (auto& cached : cachedArchives)
+            {
+                auto ba = std::make_shared<BundleArchive>(this,
+                                                          resCont,
+                                                          cached.prefix,
+                                                          location,
+                                                          cached.id,
+                                                          std::move(cached.manifest));
+                ba->SetAutostartSetting(cached.autostartSetting);
+                archives.v.emplace(cached.id, std::move(ba));
+                if (cached.id >= nextFreeId)
+                {
+                    nextFreeId = cached.id + 1;
+                }
+            }
+            archives.fingerprints.emplace(std::move(location), fingerprint);
+        }
+
+        if (!reader.AtEnd())
+        {
+            throw std::runtime_error("Trailing data in bundle cache");
+        }
+    }
+
+    std::string
+    BundleStorageFile::SaveArchives_unlocked() const
+    {
+        std::map<std::string, std::vector<std::shared_ptr<BundleArchive>>> archivesByLocation;
+        for (auto const& v : archives.v)
+        {
+            archivesByLocation[v.second->GetBundleLocation()].push_back(v.second);
+        }
+
+        CacheWriter writer;
+        writer.WriteValue(CacheMagic);
+        writer.WriteValue(CacheFormatVersion);
+        writer.WriteString(CppMicroServices_VERSION_STR);
+        writer.WriteValue(static_cast<std::int64_t>(nextFreeId));
+
+        std::uint32_t locationCount = 0;
+        auto const locationCountOffset = writer.Buffer().size();
+        writer.WriteValue(locationCount);
+        for (auto const& location : archivesByLocation)
+        {
+            auto fingerprint = archives.fingerprints.find(location.first);
+            if (fingerprint == archives.fingerprints.end())
+            {
+                continue;
+            }
+            ++locationCount;
+            writer.WriteString(location.first);
+            writer.WriteValue(fingerprint->second.size);
+            writer.WriteValue(fingerprint->second.modifiedTime);
+            writer.WriteValue(fingerprint->second.fileId);
+
+            auto const topLevelEntries = location.second.front()->GetResourceContainer()->GetTopLevelDirs();
+            writer.WriteValue(static_cast<std::uint32_t>(topLevelEntries.size()));
+            for (auto const& entry : topLevelEntries)
+            {
+                writer.WriteString(entry);
+            }
+
+            // Archives with manifest values which cannot be cached are left out,
+            // they are installed again from the top level entries.
+            std::uint32_t archiveCount = 0;
+            auto const archiveCountOffset = writer.Buffer().size();
+            writer.WriteValue(archiveCount);
+            for (auto const& ba : location.second)
+            {
+                auto const archiveOffset = writer.Buffer().size();
+                try
+                {
+                    writer.WriteValue(static_cast<std::int64_t>(ba->GetBundleId()));
+                    writer.WriteString(ba->GetResourcePrefix());
+                    writer.WriteValue(static_cast<std::int32_t>(ba->GetAutostartSetting()));
+                    writer.WriteMap(ba->GetInjectedManifest());
+                    ++archiveCount;
+                }
+                catch (std::invalid_argument const&)
+                {
+                    writer.Buffer().resize(archiveOffset);
+                }
+            }
+            std::memcpy(&writer.Buffer()[archiveCountOffset], &archiveCount, sizeof(archiveCount));
+        }
+        std::memcpy(&writer.Buffer()[locationCountOffset], &locationCount, sizeof(locationCount));
+        return std::move(writer.Buffer());
+    }
 
     std::shared_ptr<BundleArchive>
-    BundleStorageFile::CreateAndInsertArchive(std::shared_ptr<BundleResourceContainer> const& /*resCont*/
-                                              ,
-                                              std::string const& /*topLevelEntries*/
-                                              ,
-                                              ManifestT const&)
+    BundleStorageFile::CreateAndInsertArchive(std::shared_ptr<BundleResourceContainer> const& resCont,
+                                              std::string const& prefix,
+                                              ManifestT const& bundleManifest)
     {
-        throw std::logic_error("not implemented");
+        auto const location = resCont->GetLocation();
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        if (archives.fingerprints.count(location) == 0)
+        {
+            // Fingerprint the location when its first bundle is installed, so that
+            // a bundle file replaced later on invalidates the cached manifests.
+            Fingerprint fingerprint;
+            try
+            {
+                if (util::GetFileStat(location, fingerprint.size, fingerprint.modifiedTime, fingerprint.fileId))
+                {
+                    archives.fingerprints.emplace(location, fingerprint);
+                }
+            }
+            catch (std::exception const&)
+            {
+            }
+        }
+        auto id = nextFreeId++;
+        auto p = archives.v.insert(std::make_pair(
+            id,
+            std::make_shared<BundleArchive>(this, resCont, prefix, location, id, bundleManifest)));
+        return p.first->second;
     }
 
     bool
-    BundleStorageFile::RemoveArchive(BundleArchive const* /*ba*/)
+    BundleStorageFile::RemoveArchive(BundleArchive const* ba)
     {
-        throw std::logic_error("not implemented");
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        auto iter = archives.v.find(ba->GetBundleId());
+        if (iter != archives.v.end())
+        {
+            archives.v.erase(iter);
+            return true;
+        }
+        return false;
     }
 
     std::vector<std::shared_ptr<BundleArchive>>
     BundleStorageFile::GetAllBundleArchives() const
     {
-        throw std::logic_error("not implemented");
+        std::vector<std::shared_ptr<BundleArchive>> res;
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        for (auto const& v : archives.v)
+        {
+            res.emplace_back(v.second);
+        }
+        return res;
     }
 
     std::vector<long>
     BundleStorageFile::GetStartOnLaunchBundles() const
     {
-        throw std::logic_error("not implemented");
+        std::vector<long> res;
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        for (auto& v : archives.v)
+        {
+            if (v.second->GetAutostartSetting() != -1)
+            {
+                res.emplace_back(v.second->GetBundleId());
+            }
+        }
+        return res;
     }
 
     void
     BundleStorageFile::Close()
     {
-        throw std::logic_error("not implemented");
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        try
+        {
+            // Write to a temporary file first, so that a failing write never leaves
+            // a truncated cache behind.
+            std::string const tmpFile = cacheFile + ".tmp";
+            {
+                auto const data = SaveArchives_unlocked();
+                std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+                if (!out.write(data.data(), static_cast<std::streamsize>(data.size())) || !out.flush())
+                {
+                    throw std::runtime_error("Cannot write " + tmpFile);
+                }
+            }
+            if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+            {
+                // std::rename does not replace existing files on all platforms
+                std::remove(cacheFile.c_str());
+                if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+                {
+                    std::remove(tmpFile.c_str());
+                    throw std::runtime_error("Cannot replace " + cacheFile);
+                }
+            }
+        }
+        catch (std::exception const& e)
+        {
+            // The previous cache, if any, is left in place.
+            if (sink)
+            {
+                DIAG_LOG(*sink) << "Failed to write the bundle cache " << cacheFile << " (" << e.what() << ")\n";
+            }
+        }
+        archives.v.clear();
+        archives.fingerprints.clear();
+    }
+
+    bool
+    BundleStorageFile::IsPersistent() const
+    {
+        return true;
     }
 } // namespace cppmicroservices
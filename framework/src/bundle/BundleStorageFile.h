@@ -23,20 +23,50 @@
 #ifndef CPPMICROSERVICES_BUNDLESTORAGEFILE_H
 #define CPPMICROSERVICES_BUNDLESTORAGEFILE_H
 
+#include "cppmicroservices/detail/Log.h"
+#include "cppmicroservices/detail/Threads.h"
+
 #include "BundleStorage.h"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
 namespace cppmicroservices
 {
 
-    class BundleStorageFile : public BundleStorage
+    /**
+     * Bundle storage which records its bundle archives in a cache file when it
+     * is closed and re-creates them from that file when it is opened again.
+     *
+     * For each bundle location, the cache holds the file size, modification time
+     * and file id of the location, the top level entries of its resource container
+     * and, for each installed bundle, its id, its autostart setting and its manifest
+     * in a compact binary form. Re-created archives carry their manifest as an
+     * injected manifest, so neither the bundle file nor its manifest.json has to
+     * be read to install them. Locations whose fingerprint changed are dropped
+     * from the cache.
+     */
+    class US_ABI_TEST BundleStorageFile : public BundleStorage
     {
 
       public:
-        BundleStorageFile();
+        /**
+         * Open the bundle cache in a directory.
+         *
+         * @param storagePath The directory holding the cache file.
+         * @param cleanStorage Discard the archives recorded by previous framework
+         *        instances instead of re-creating them.
+         * @param sink The diagnostic sink reporting a failure to write the cache.
+         */
+        BundleStorageFile(std::string const& storagePath,
+                          bool cleanStorage,
+                          std::shared_ptr<detail::LogSink> sink = nullptr);
 
         std::shared_ptr<BundleArchive> CreateAndInsertArchive(std::shared_ptr<BundleResourceContainer> const& resCont,
                                                               std::string const& topLevelEntry,
-                                                              ManifestT const&) override;
+                                                              ManifestT const& bundleManifest) override;
 
         bool RemoveArchive(BundleArchive const* ba) override;
 
@@ -45,6 +75,32 @@ namespace cppmicroservices
         std::vector<long> GetStartOnLaunchBundles() const override;
 
         void Close() override;
+
+        bool IsPersistent() const override;
+
+      private:
+        struct Fingerprint
+        {
+            std::uint64_t size;
+            std::int64_t modifiedTime;
+            std::uint64_t fileId;
+        };
+
+        void LoadArchives_unlocked(std::string const& data);
+        std::string SaveArchives_unlocked() const;
+
+        const std::string cacheFile;
+        std::shared_ptr<detail::LogSink> const sink;
+        long nextFreeId;
+        /**
+         * Bundle id sorted list of all active bundle archives, together with the
+         * fingerprints of their locations at the time they were installed.
+         */
+        struct : detail::MultiThreaded<>
+        {
+            std::map<long, std::shared_ptr<BundleArchive>> v;
+            std::unordered_map<std::string, Fingerprint> fingerprints;
+        } archives;
     };
 } // namespace cppmicroservices
 
@@ -44,11 +44,20 @@ namespace cppmicroservices
         const std::string BUNDLE_MANIFESTVERSION = "bundle.manifest_version";
         const std::string BUNDLE_ACTIVATIONPOLICY = "bundle.activation_policy";
         const std::string ACTIVATION_LAZY = "lazy";
+        const std::string BUNDLE_STARTDEPENDENCIES = "bundle.start_dependencies";
+        const std::string BUNDLE_STARTLEVEL = "bundle.start_level";
+        const std::string BUNDLE_PRELOAD = "bundle.preload";
         const std::string FRAMEWORK_VERSION = "org.cppmicroservices.framework.version";
         const std::string FRAMEWORK_VENDOR = "org.cppmicroservices.framework.vendor";
         const std::string FRAMEWORK_STORAGE = "org.cppmicroservices.framework.storage";
         const std::string FRAMEWORK_STORAGE_CLEAN = "org.cppmicroservices.framework.storage.clean";
         const std::string FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT = "onFirstInit";
+        const std::string FRAMEWORK_BUNDLE_CACHE = "org.cppmicroservices.framework.bundle.cache";
+        const std::string FRAMEWORK_BEGINNING_STARTLEVEL = "org.osgi.framework.startlevel.beginning";
+        const std::string FRAMEWORK_STARTLEVEL_CONCURRENT = "org.cppmicroservices.framework.startlevel.concurrent";
+        const std::string FRAMEWORK_BUNDLE_PRELOAD = "org.cppmicroservices.framework.bundle.preload";
+        const std::string FRAMEWORK_STARTUP_TRACE = "org.cppmicroservices.framework.startup.trace";
+        const std::string FRAMEWORK_FAST_SHUTDOWN = "org.cppmicroservices.framework.shutdown.fast";
         const std::string FRAMEWORK_THREADING_SUPPORT = "org.cppmicroservices.framework.threading.support";
         const std::string FRAMEWORK_THREADING_SINGLE = "single";
         const std::string FRAMEWORK_THREADING_MULTI = "multi";
@@ -67,6 +76,7 @@ namespace cppmicroservices
         const std::string SCOPE_SINGLETON = "singleton";
         const std::string SCOPE_BUNDLE = "bundle";
         const std::string SCOPE_PROTOTYPE = "prototype";
+        const std::string SERVICE_PROTOTYPE_POOL_SIZE = "org.cppmicroservices.service.prototype.pool.size";
         const std::string LIBRARY_LOAD_OPTIONS = "org.cppmicroservices.library.load.options";
 
     } // namespace Constants
@@ -28,12 +28,14 @@ US_MSVC_DISABLE_WARNING(4355)
 
 #include "cppmicroservices/BundleInitialization.h"
 #include "cppmicroservices/Constants.h"
+#include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
 
 #include "cppmicroservices/util/FileSystem.h"
 #include "cppmicroservices/util/String.h"
 
 #include "BundleContextPrivate.h"
+#include "BundleStorageFile.h"
 #include "BundleStorageMemory.h"
 #include "FrameworkPrivate.h"
 
@@ -69,6 +71,20 @@ namespace cppmicroservices
 
         configuration.emplace(std::make_pair(Constants::FRAMEWORK_STORAGE, Any(FWDIR_DEFAULT)));
 
+        // The persistent bundle cache is off by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_BUNDLE_CACHE, Any(false)));
+
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_BEGINNING_STARTLEVEL, Any(1)));
+
+        // The bundles of one start level are started one after the other by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_STARTLEVEL_CONCURRENT, Any(false)));
+
+        // Bundles are not preloaded by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_BUNDLE_PRELOAD, Any(false)));
+
+        // Bundles are stopped one after the other by default
+        configuration.emplace(std::make_pair(Constants::FRAMEWORK_FAST_SHUTDOWN, Any(false)));
+
         configuration[Constants::FRAMEWORK_VERSION] = std::string(CppMicroServices_VERSION_STR);
         configuration[Constants::FRAMEWORK_VENDOR] = std::string("CppMicroServices");
 
@@ -91,9 +107,12 @@ namespace cppmicroservices
         , serviceHooks(this)
         , bundleHooks(this)
         , bundleRegistry(std::make_unique<BundleRegistry>(this))
+        , preloader(this)
         , firstInit(true)
         , initCount(0)
         , libraryLoadOptions(0)
+        , activeStartLevel(0)
+        , fastShutdown(false)
         , stopped(false)
     {
         auto enableDiagLog = any_cast<bool>(frameworkProperties.at(Constants::FRAMEWORK_LOG));
@@ -123,11 +142,28 @@ namespace cppmicroservices
         DIAG_LOG(*sink) << "initializing";
         initCount++;
 
+        auto startupTrace = frameworkProperties.find(Constants::FRAMEWORK_STARTUP_TRACE);
+        if (startupTrace != frameworkProperties.end())
+        {
+            if (startupTrace->second.Type() == typeid(std::string))
+            {
+                profiler.Open(ref_any_cast<std::string>(startupTrace->second));
+            }
+            else
+            {
+                DIAG_LOG(*sink) << "Ignoring " << Constants::FRAMEWORK_STARTUP_TRACE
+                                << ", its value is not a string.";
+            }
+        }
+        StartupProfiler::Span span(profiler, "Framework::Init", "framework");
+
+        bool cleanStorage = false;
         auto storageCleanProp = frameworkProperties.find(Constants::FRAMEWORK_STORAGE_CLEAN);
         if (firstInit && storageCleanProp != frameworkProperties.end()
             && storageCleanProp->second == Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT)
         {
             // DeleteFWDir();
+            cleanStorage = true;
             firstInit = false;
         }
 
@@ -138,8 +174,15 @@ namespace cppmicroservices
 
         frameworkProperties[Constants::FRAMEWORK_UUID] = ss.str();
 
-        // $TODO we only support non-persistent (main memory) storage yet
-        if (!storage)
+        if (any_cast<bool>(frameworkProperties.at(Constants::FRAMEWORK_BUNDLE_CACHE)))
+        {
+            // The file storage writes its archives when it is closed, re-open it
+            // on every init to pick them up again.
+            storage = std::make_unique<BundleStorageFile>(GetPersistentStoragePath(this, "bundles", true),
+                                                          cleanStorage,
+                                                          sink);
+        }
+        else if (!storage)
         {
             storage = std::make_unique<BundleStorageMemory>();
         }
@@ -223,17 +266,47 @@ namespace cppmicroservices
         }
         DIAG_LOG(*sink) << "Library Load Options = " << libraryLoadOptions;
 #endif
+
+        // Start level changes run on their own thread, which cannot report a
+        // bad value, so fall back to the default here.
+        if (frameworkProperties[Constants::FRAMEWORK_STARTLEVEL_CONCURRENT].Type() != typeid(bool))
+        {
+            DIAG_LOG(*sink) << "Unable to read " << Constants::FRAMEWORK_STARTLEVEL_CONCURRENT
+                            << " from config, it is not a boolean.";
+            frameworkProperties[Constants::FRAMEWORK_STARTLEVEL_CONCURRENT] = false;
+        }
+
+        preloader.Open();
     }
 
     void
     CoreBundleContext::Uninit0()
     {
         DIAG_LOG(*sink) << "uninit";
+        preloader.Close();
+        // Writes the trace if the framework stops before it started.
+        CloseStartupTrace();
         logger->Close();
         serviceHooks.Close();
         systemBundle->UninitSystemBundle();
     }
 
+    void
+    CoreBundleContext::CloseStartupTrace()
+    {
+        try
+        {
+            profiler.Close();
+        }
+        catch (...)
+        {
+            listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
+                                                        MakeBundle(systemBundle),
+                                                        "Failed to write the start-up trace",
+                                                        std::current_exception()));
+        }
+    }
+
     void
     CoreBundleContext::Uninit1()
     {
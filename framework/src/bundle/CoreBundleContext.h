@@ -47,12 +47,14 @@ as specified in the OSGi R4.2 specifications.
 #include "cppmicroservices/detail/Threads.h"
 
 #include "BundleHooks.h"
+#include "BundlePreloader.h"
 #include "BundleRegistry.h"
 #include "CFRLogger.h"
 #include "Resolver.h"
 #include "ServiceHooks.h"
 #include "ServiceListeners.h"
 #include "ServiceRegistry.h"
+#include "StartupProfiler.h"
 
 #include <map>
 #include <ostream>
@@ -123,6 +125,11 @@ namespace cppmicroservices
          */
         std::shared_ptr<detail::LogSink> sink;
 
+        /**
+         * Start-up timeline, see Constants::FRAMEWORK_STARTUP_TRACE.
+         */
+        StartupProfiler profiler;
+
         /**
          * Bundle Storage
          */
@@ -170,6 +177,11 @@ namespace cppmicroservices
          */
         std::unique_ptr<BundleRegistry> bundleRegistry;
 
+        /**
+         * Preloads installed bundles, see Constants::FRAMEWORK_BUNDLE_PRELOAD.
+         */
+        BundlePreloader preloader;
+
         bool firstInit;
 
         /**
@@ -186,6 +198,17 @@ namespace cppmicroservices
 
         std::function<bool(cppmicroservices::Bundle const&)> validationFunc;
 
+        /**
+         * The active start level of the framework, 0 while it is not started.
+         */
+        std::atomic<int> activeStartLevel;
+
+        /**
+         * True while the framework stops all bundles in the fast shutdown mode,
+         * see Constants::FRAMEWORK_FAST_SHUTDOWN.
+         */
+        std::atomic<bool> fastShutdown;
+
         ~CoreBundleContext();
 
         // thread-safe shared_from_this implementation
@@ -199,6 +222,13 @@ namespace cppmicroservices
 
         void Uninit1();
 
+        /**
+         * Stops recording the start-up timeline and writes it, see
+         * Constants::FRAMEWORK_STARTUP_TRACE. A failure to write it is
+         * reported as a FRAMEWORK_WARNING event.
+         */
+        void CloseStartupTrace();
+
         /**
          * Called when framework shutdown/startup has begun.
          * This blocks (while returned object is held):
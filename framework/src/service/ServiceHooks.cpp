@@ -113,17 +113,20 @@ namespace cppmicroservices
                                           std::string const& filter,
                                           std::vector<ServiceReferenceBase>& refs)
     {
-        std::vector<ServiceRegistrationBase> srl;
-        coreCtx->services.Get_unlocked(us_service_interface_iid<ServiceFindHook>(), srl);
-        if (!srl.empty())
+        if (!coreCtx->services.HasHooks())
+        {
+            return;
+        }
+
+        auto srl = coreCtx->services.GetHooks(us_service_interface_iid<ServiceFindHook>());
+        if (srl)
         {
             ShrinkableVector<ServiceReferenceBase> filtered(refs);
 
             auto selfBundle = GetBundleContext().GetBundle();
-            std::sort(srl.begin(), srl.end());
-            for (auto fhrIter = srl.rbegin(), fhrEnd = srl.rend(); fhrIter != fhrEnd; ++fhrIter)
+            for (auto const& fhr : *srl)
             {
-                ServiceReference<ServiceFindHook> sr = fhrIter->GetReference();
+                ServiceReference<ServiceFindHook> sr = fhr.GetReference();
                 auto fh
                     = std::static_pointer_cast<ServiceFindHook>(sr.d.Load()->GetService(GetPrivate(selfBundle).get()));
                 if (fh)
@@ -150,11 +153,14 @@ namespace cppmicroservices
     ServiceHooks::FilterServiceEventReceivers(ServiceEvent const& evt,
                                               ServiceListeners::ServiceListenerEntries& receivers)
     {
-        std::vector<ServiceRegistrationBase> eventListenerHooks;
-        coreCtx->services.Get(us_service_interface_iid<ServiceEventListenerHook>(), eventListenerHooks);
-        if (!eventListenerHooks.empty())
+        if (!coreCtx->services.HasHooks())
+        {
+            return;
+        }
+
+        auto eventListenerHooks = coreCtx->services.GetHooks(us_service_interface_iid<ServiceEventListenerHook>());
+        if (eventListenerHooks)
         {
-            std::sort(eventListenerHooks.begin(), eventListenerHooks.end());
             std::map<BundleContext, std::vector<ServiceListenerHook::ListenerInfo>> listeners;
             for (auto& sle : receivers)
             {
@@ -172,10 +178,9 @@ namespace cppmicroservices
                 shrinkableListeners);
 
             auto selfBundle = GetBundleContext().GetBundle();
-            for (auto sriIter = eventListenerHooks.rbegin(), sriEnd = eventListenerHooks.rend(); sriIter != sriEnd;
-                 ++sriIter)
+            for (auto const& sri : *eventListenerHooks)
             {
-                ServiceReference<ServiceEventListenerHook> sr = sriIter->GetReference();
+                ServiceReference<ServiceEventListenerHook> sr = sri.GetReference();
                 auto elh = std::static_pointer_cast<ServiceEventListenerHook>(
                     sr.d.Load()->GetService(GetPrivate(selfBundle).get()));
                 if (elh)
@@ -42,6 +42,7 @@ US_MSVC_PUSH_DISABLE_WARNING(4180) // qualifier applied to function type has no
 #include "ServiceReferenceBasePrivate.h"
 
 #include <cassert>
+#include <sstream>
 #include <utility>
 
 namespace cppmicroservices
@@ -323,6 +324,15 @@ namespace cppmicroservices
             for (auto& bundleListener : bundleListeners.second)
             {
                 auto bundle_ = bundleListeners.first->bundle.lock();
+                StartupProfiler::Span span(coreCtx->profiler, "Bundle listener", "listener");
+                if (span.IsRecording())
+                {
+                    std::ostringstream type;
+                    type << evt.GetType();
+                    span.AddArg("event", type.str());
+                    span.AddArg("bundle", evt.GetBundle().GetSymbolicName());
+                    span.AddArg("listener bundle", bundle_ ? bundle_->symbolicName : std::string());
+                }
                 try
                 {
                     std::get<0>(bundleListener.second)(evt);
@@ -449,10 +459,16 @@ namespace cppmicroservices
     void
     ServiceListeners::GetMatchingServiceListeners(ServiceEvent const& evt, ServiceListenerEntries& set)
     {
-        // Filter the original set of listeners
-        ServiceListenerEntries receivers = (this->Lock(), serviceSet);
-        // This must not be called with any locks held
-        coreCtx->serviceHooks.FilterServiceEventReceivers(evt, receivers);
+        // Filter the original set of listeners. Without hooks, all listeners
+        // are receivers and the set does not need to be copied.
+        ServiceListenerEntries receivers;
+        bool const filtered = coreCtx->services.HasHooks();
+        if (filtered)
+        {
+            receivers = (this->Lock(), serviceSet);
+            // This must not be called with any locks held
+            coreCtx->serviceHooks.FilterServiceEventReceivers(evt, receivers);
+        }
 
         // Get a copy of the service reference and keep it until we are
         // done with its properties.
@@ -462,10 +478,11 @@ namespace cppmicroservices
         {
             auto l = this->Lock();
             US_UNUSED(l);
+            auto const& candidates = filtered ? receivers : serviceSet;
             // Check complicated or empty listener filters
             for (auto& sse : complicatedListeners)
             {
-                if (receivers.count(sse) == 0)
+                if (candidates.count(sse) == 0)
                 {
                     continue;
                 }
@@ -480,11 +497,11 @@ namespace cppmicroservices
             auto const& c = ref_any_cast<std::vector<std::string>>(props->ValueByRef_unlocked(Constants::OBJECTCLASS));
             for (auto& objClass : c)
             {
-                AddToSet_unlocked(set, receivers, OBJECTCLASS_IX, objClass);
+                AddToSet_unlocked(set, candidates, OBJECTCLASS_IX, objClass);
             }
 
             auto service_id = any_cast<long>(props->Value_unlocked(Constants::SERVICE_ID).first);
-            AddToSet_unlocked(set, receivers, SERVICE_ID_IX, cppmicroservices::util::ToString((service_id)));
+            AddToSet_unlocked(set, candidates, SERVICE_ID_IX, cppmicroservices::util::ToString((service_id)));
         }
     }
 
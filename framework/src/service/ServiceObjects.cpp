@@ -55,8 +55,7 @@ namespace cppmicroservices
         {
             InterfaceMapConstPtr result;
 
-            bool isPrototypeScope
-                = m_reference.GetProperty(Constants::SERVICE_SCOPE).ToString() == Constants::SCOPE_PROTOTYPE;
+            bool isPrototypeScope = m_reference.GetServiceScope() == Constants::SCOPE_PROTOTYPE;
 
             if (isPrototypeScope)
             {
@@ -96,11 +95,17 @@ namespace cppmicroservices
         const InterfaceMapConstPtr interfaceMap;
         const ServiceReferenceBase sref;
         const std::weak_ptr<BundlePrivate> b;
+        // copy of interfaceMap handed out by ServiceObjectsBase::GetServiceInterfaceMap
+        const InterfaceMapConstPtr interfaceMapCopy;
 
-        UngetHelper(InterfaceMapConstPtr im, ServiceReferenceBase const& sr, std::shared_ptr<BundlePrivate> const& b)
+        UngetHelper(InterfaceMapConstPtr im,
+                    ServiceReferenceBase const& sr,
+                    std::shared_ptr<BundlePrivate> const& b,
+                    InterfaceMapConstPtr copy = nullptr)
             : interfaceMap(std::move(im))
             , sref(sr)
             , b(b)
+            , interfaceMapCopy(std::move(copy))
         {
         }
         ~UngetHelper()
@@ -110,8 +115,7 @@ namespace cppmicroservices
                 auto bundle = b.lock();
                 if (sref)
                 {
-                    bool isPrototypeScope
-                        = sref.GetProperty(Constants::SERVICE_SCOPE).ToString() == Constants::SCOPE_PROTOTYPE;
+                    bool isPrototypeScope = sref.GetServiceScope() == Constants::SCOPE_PROTOTYPE;
 
                     if (isPrototypeScope)
                     {
@@ -191,8 +195,9 @@ namespace cppmicroservices
             return nullptr;
         }
 
-        std::shared_ptr<UngetHelper> h(new UngetHelper { result, d->m_reference, bundle_ });
-        return InterfaceMapConstPtr(h, h->interfaceMap.get());
+        // unget the instance obtained from the registration, not the copy
+        auto h = std::make_shared<UngetHelper>(interfaceMap, d->m_reference, bundle_, result);
+        return InterfaceMapConstPtr(h, h->interfaceMapCopy.get());
     }
 
     ServiceReferenceBase
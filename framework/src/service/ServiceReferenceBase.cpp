@@ -23,7 +23,6 @@
 #include "cppmicroservices/ServiceReferenceBase.h"
 
 #include "cppmicroservices/Bundle.h"
-#include "cppmicroservices/Constants.h"
 
 #include "BundlePrivate.h"
 #include "ServiceReferenceBasePrivate.h"
@@ -89,6 +88,36 @@ namespace cppmicroservices
         return refP->coreInfo->properties.Keys_unlocked();
     }
 
+    long
+    ServiceReferenceBase::GetServiceId() const
+    {
+        auto refP = d.Load();
+        return refP->coreInfo ? refP->coreInfo->serviceId : 0;
+    }
+
+    int
+    ServiceReferenceBase::GetServiceRanking() const
+    {
+        auto refP = d.Load();
+        return refP->coreInfo ? refP->coreInfo->serviceRanking.load() : 0;
+    }
+
+    std::vector<std::string> const&
+    ServiceReferenceBase::GetObjectClasses() const
+    {
+        static std::vector<std::string> const noObjectClasses;
+        auto refP = d.Load();
+        return refP->coreInfo ? refP->coreInfo->objectClasses : noObjectClasses;
+    }
+
+    std::string const&
+    ServiceReferenceBase::GetServiceScope() const
+    {
+        static std::string const noScope;
+        auto refP = d.Load();
+        return refP->coreInfo ? refP->coreInfo->serviceScope : noScope;
+    }
+
     Bundle
     ServiceReferenceBase::GetBundle() const
     {
@@ -146,35 +175,11 @@ namespace cppmicroservices
             return false;
         }
 
-        /// A deadlock caused by mutex order locking will happen if these two scoped blocks
-        /// are combined into one. Multiple threads can enter this function as a result of
-        /// adding/removing ServiceReferenceBase objects from STL containers. If that occurs
-        /// AND these two scoped blocks are combined into one such that both "Lock()" calls
-        /// happen in the same scoped block, sporadic deadlocks will occur.
-        Any anyR1;
-        Any anyId1;
-        {
-            auto l1 = self->coreInfo->properties.Lock();
-            US_UNUSED(l1);
-            anyR1 = self->coreInfo->properties.Value_unlocked(Constants::SERVICE_RANKING).first;
-            assert(anyR1.Empty() || anyR1.Type() == typeid(int));
-            anyId1 = self->coreInfo->properties.Value_unlocked(Constants::SERVICE_ID).first;
-            assert(anyId1.Empty() || anyId1.Type() == typeid(long int));
-        }
-
-        Any anyR2;
-        Any anyId2;
-        {
-            auto l2 = ref->coreInfo->properties.Lock();
-            US_UNUSED(l2);
-            anyR2 = ref->coreInfo->properties.Value_unlocked(Constants::SERVICE_RANKING).first;
-            assert(anyR2.Empty() || anyR2.Type() == typeid(int));
-            anyId2 = ref->coreInfo->properties.Value_unlocked(Constants::SERVICE_ID).first;
-            assert(anyId2.Empty() || anyId2.Type() == typeid(long int));
-        }
-
-        int const r1 = anyR1.Empty() ? 0 : *any_cast<int>(&anyR1);
-        int const r2 = anyR2.Empty() ? 0 : *any_cast<int>(&anyR2);
+        // The ranking and id are cached in the core info, so comparing references
+        // (e.g. while sorting them or keeping them in ordered containers) does not
+        // lock the service properties.
+        int const r1 = self->coreInfo->serviceRanking.load();
+        int const r2 = ref->coreInfo->serviceRanking.load();
 
         if (r1 != r2)
         {
@@ -183,12 +188,9 @@ namespace cppmicroservices
         }
         else
         {
-            long int const id1 = *any_cast<long int>(&anyId1);
-            long int const id2 = *any_cast<long int>(&anyId2);
-
             // otherwise compare using IDs,
             // is less than if it has a higher ID.
-            return id2 < id1;
+            return ref->coreInfo->serviceId < self->coreInfo->serviceId;
         }
     }
 
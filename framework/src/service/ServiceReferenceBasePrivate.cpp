@@ -24,6 +24,8 @@
 
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/PooledPrototypeServiceFactory.h"
+#include "cppmicroservices/PrototypeServiceFactory.h"
 #include "cppmicroservices/SecurityException.h"
 #include "cppmicroservices/ServiceException.h"
 #include "cppmicroservices/ServiceFactory.h"
@@ -35,6 +37,10 @@
 #include "ServiceRegistry.h"
 
 #include <cassert>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 US_MSVC_DISABLE_WARNING(4503) // decorated name length exceeded, name was truncated
 
@@ -151,15 +157,52 @@ namespace cppmicroservices
             auto reg = registration.lock();
             if (coreInfo->available && reg)
             {
+                auto b = GetPrivate(bundle).get();
+                if (coreInfo->prototypePoolSize > 0)
+                {
+                    auto l = LockServiceRegistration();
+                    US_UNUSED(l);
+                    auto poolIter = coreInfo->prototypeServicePool.find(b);
+                    if (coreInfo->available && poolIter != coreInfo->prototypeServicePool.end())
+                    {
+                        s = std::move(poolIter->second.back());
+                        poolIter->second.pop_back();
+                        if (poolIter->second.empty())
+                        {
+                            coreInfo->prototypeServicePool.erase(poolIter);
+                        }
+                        coreInfo->prototypeServiceInstances[b].insert(s);
+                        RecordServiceUse_unlocked(b);
+                        return s;
+                    }
+                }
+
                 auto factory
                     = std::static_pointer_cast<ServiceFactory>(reg->GetService("org.cppmicroservices.factory"));
-                s = GetServiceFromFactory(GetPrivate(bundle).get(), factory);
-                LockServiceRegistration(), coreInfo->prototypeServiceInstances[GetPrivate(bundle).get()].push_back(s);
+                s = GetServiceFromFactory(b, factory);
+                if (s)
+                {
+                    auto l = LockServiceRegistration();
+                    US_UNUSED(l);
+                    coreInfo->prototypeServiceInstances[b].insert(s);
+                    RecordServiceUse_unlocked(b);
+                }
             }
         }
         return s;
     }
 
+    void
+    ServiceReferenceBasePrivate::RecordServiceUse_unlocked(BundlePrivate* bundle)
+    {
+        if (auto reg = registration.lock())
+        {
+            auto l = bundle->usedServices.Lock();
+            US_UNUSED(l);
+            bundle->usedServices.v.try_emplace(reg.get(), reg);
+        }
+    }
+
     std::shared_ptr<void>
     ServiceReferenceBasePrivate::GetService(BundlePrivate* bundle)
     {
@@ -189,7 +232,26 @@ namespace cppmicroservices
         {
             return s;
         }
+
+        // Fast path for singleton services: if the bundle already uses the service,
+        // only its use counter needs to be incremented. This is done under a shared
+        // lock, so concurrent callers neither take the registration locks nor
+        // serialize on each other. The counter of a bundle cannot drop to zero (and
+        // its entry cannot be removed) while the shared lock is held.
+        if (!coreInfo->isFactory)
+        {
+            std::shared_lock<std::shared_mutex> dl(coreInfo->dependentsMutex);
+            auto depIter = coreInfo->dependents.find(bundle);
+            if (coreInfo->dependents.end() != depIter && depIter->second.load() > 0 && coreInfo->available)
+            {
+                ++depIter->second;
+                return coreInfo->service;
+            }
+        }
+
         std::shared_ptr<ServiceFactory> serviceFactory;
+        std::shared_future<InterfaceMapConstPtr> pending;
+        std::shared_ptr<std::promise<InterfaceMapConstPtr>> creation;
 
         std::unordered_set<ServiceRegistrationBasePrivate*>* marks = nullptr;
         ServiceRegistrationBasePrivate* registrationPtr = registration.lock().get();
@@ -222,8 +284,13 @@ namespace cppmicroservices
             serviceFactory
                 = std::static_pointer_cast<ServiceFactory>(reg->GetService_unlocked("org.cppmicroservices.factory"));
 
-            auto res = coreInfo->dependents.insert(std::make_pair(bundle, 0));
+            std::unique_lock<std::shared_mutex> dl(coreInfo->dependentsMutex);
+            auto res = coreInfo->dependents.try_emplace(bundle, 0);
             auto& depCounter = res.first->second;
+            if (res.second)
+            {
+                RecordServiceUse_unlocked(bundle);
+            }
 
             // No service factory, just return the registered service directly.
             if (!serviceFactory)
@@ -264,6 +331,20 @@ namespace cppmicroservices
             }
 
             marks->insert(registrationPtr);
+
+            // Only one thread per bundle calls the factory. Other threads requesting the
+            // service for the same bundle wait for its result, while requests for other
+            // bundles proceed concurrently.
+            auto pendingIter = coreInfo->pendingBundleServiceInstances.find(bundle);
+            if (coreInfo->pendingBundleServiceInstances.end() != pendingIter)
+            {
+                pending = pendingIter->second;
+            }
+            else
+            {
+                creation = std::make_shared<std::promise<InterfaceMapConstPtr>>();
+                coreInfo->pendingBundleServiceInstances.emplace(bundle, creation->get_future().share());
+            }
         }
 
         // Calling into a service factory could cause re-entrancy into the
@@ -272,24 +353,62 @@ namespace cppmicroservices
         // the possibility of a deadlock. It does not however eliminate the
         // possibility of infinite recursion.
 
+        if (pending.valid())
         {
-            auto l = LockServiceRegistration();
-            US_UNUSED(l);
+            // Rethrows the exception, if the factory call of the other thread threw.
+            // Unlike recursion on the same thread, a factory waiting for this thread
+            // cannot be detected and deadlocks here, see ServiceFactory::GetService.
+            s = pending.get();
+            if (!s || s->empty())
+            {
+                return s;
+            }
 
-            if (coreInfo->bundleServiceInstance.end() != coreInfo->bundleServiceInstance.find(bundle))
             {
-                ++coreInfo->dependents.at(bundle);
-                return coreInfo->bundleServiceInstance.at(bundle);
+                auto l = LockServiceRegistration();
+                US_UNUSED(l);
+                std::unique_lock<std::shared_mutex> dl(coreInfo->dependentsMutex);
+                auto serviceIter = coreInfo->bundleServiceInstance.find(bundle);
+                if (coreInfo->bundleServiceInstance.end() != serviceIter)
+                {
+                    auto res = coreInfo->dependents.try_emplace(bundle, 0);
+                    if (res.second)
+                    {
+                        RecordServiceUse_unlocked(bundle);
+                    }
+                    ++res.first->second;
+                    return serviceIter->second;
+                }
             }
+
+            // All other users released the instance before this thread could
+            // take its share of it, so a new one must be requested.
+            marks->erase(registrationPtr);
+            marks = nullptr;
+            return GetServiceInterfaceMap(bundle);
         }
 
-        s = GetServiceFromFactory(bundle, serviceFactory);
+        try
+        {
+            s = GetServiceFromFactory(bundle, serviceFactory);
+        }
+        catch (...)
+        {
+            LockServiceRegistration(), coreInfo->pendingBundleServiceInstances.erase(bundle);
+            creation->set_exception(std::current_exception());
+            throw;
+        }
 
         {
             auto l = LockServiceRegistration();
             US_UNUSED(l);
+            std::unique_lock<std::shared_mutex> dl(coreInfo->dependentsMutex);
 
-            coreInfo->dependents.insert(std::make_pair(bundle, 0));
+            coreInfo->pendingBundleServiceInstances.erase(bundle);
+            if (coreInfo->dependents.try_emplace(bundle, 0).second)
+            {
+                RecordServiceUse_unlocked(bundle);
+            }
 
             if (s && !s->empty())
             {
@@ -301,6 +420,7 @@ namespace cppmicroservices
                 ++coreInfo->dependents.at(bundle);
             }
         }
+        creation->set_value(s);
         return s;
     }
 
@@ -308,8 +428,8 @@ namespace cppmicroservices
     ServiceReferenceBasePrivate::UngetPrototypeService(std::shared_ptr<BundlePrivate> const& bundle,
                                                        InterfaceMapConstPtr const& service)
     {
-        std::list<InterfaceMapConstPtr> prototypeServiceMaps;
         std::shared_ptr<ServiceFactory> sf;
+        bool poolService = false;
 
         {
             auto reg = registration.lock();
@@ -321,60 +441,128 @@ namespace cppmicroservices
                 return false;
             }
 
-            prototypeServiceMaps = iter->second;
+            auto serviceIter = iter->second.find(service);
+            if (serviceIter == iter->second.end())
+            {
+                return false;
+            }
+            iter->second.erase(serviceIter);
+            if (iter->second.empty())
+            {
+                coreInfo->prototypeServiceInstances.erase(iter);
+            }
+
+            if (!reg)
+            {
+                return true;
+            }
             sf = std::static_pointer_cast<ServiceFactory>(reg->GetService_unlocked("org.cppmicroservices.factory"));
+
+            if (coreInfo->prototypePoolSize > 0 && coreInfo->available)
+            {
+                auto poolIter = coreInfo->prototypeServicePool.find(bundle.get());
+                poolService = poolIter == coreInfo->prototypeServicePool.end()
+                              || poolIter->second.size() < coreInfo->prototypePoolSize;
+            }
         }
 
         if (!sf)
         {
-            return false;
+            return true;
         }
 
-        for (auto& prototypeServiceMap : prototypeServiceMaps)
+        // only factories implementing the reset hook can be pooled, whatever the
+        // registration properties claim
+        auto pooledFactory = poolService ? std::dynamic_pointer_cast<PooledPrototypeServiceFactory>(sf) : nullptr;
+        if (pooledFactory)
         {
-            // compare the contents of the map
-            if (*service.get() == *prototypeServiceMap.get())
+            bool reset = false;
+            try
             {
-                try
-                {
-                    sf->UngetService(MakeBundle(bundle), ServiceRegistrationBase(registration.lock()), service);
-                }
-                catch (std::exception const& ex)
-                {
-                    if (auto bundle_ = coreInfo->bundle_.lock())
-                    {
-                        std::string message("ServiceFactory threw an exception");
-                        bundle_->coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(
-                            FrameworkEvent::Type::FRAMEWORK_ERROR,
-                            MakeBundle(bundle->shared_from_this()),
-                            message,
-                            std::make_exception_ptr(
-                                ServiceException(ex.what(), ServiceException::Type::FACTORY_EXCEPTION))));
-                    }
-                }
+                reset = pooledFactory->ResetService(
+                    MakeBundle(bundle),
+                    ServiceRegistrationBase(registration.lock()),
+                    service);
+            }
+            catch (std::exception const& ex)
+            {
+                SendFactoryExceptionEvent(bundle, ex);
+            }
 
+            if (reset)
+            {
                 auto l = LockServiceRegistration();
                 US_UNUSED(l);
-                auto iter = coreInfo->prototypeServiceInstances.find(bundle.get());
-                if (iter == coreInfo->prototypeServiceInstances.end())
+                auto& pool = coreInfo->prototypeServicePool[bundle.get()];
+                if (coreInfo->available && pool.size() < coreInfo->prototypePoolSize)
                 {
+                    pool.push_back(service);
                     return true;
                 }
-
-                auto serviceIter = std::find(iter->second.begin(), iter->second.end(), service);
-                if (serviceIter != iter->second.end())
-                {
-                    iter->second.erase(serviceIter);
-                }
-                if (iter->second.empty())
+                if (pool.empty())
                 {
-                    coreInfo->prototypeServiceInstances.erase(iter);
+                    coreInfo->prototypeServicePool.erase(bundle.get());
                 }
-                return true;
             }
         }
 
-        return false;
+        try
+        {
+            sf->UngetService(MakeBundle(bundle), ServiceRegistrationBase(registration.lock()), service);
+        }
+        catch (std::exception const& ex)
+        {
+            SendFactoryExceptionEvent(bundle, ex);
+        }
+        return true;
+    }
+
+    void
+    ServiceReferenceBasePrivate::ReleasePrototypeServicePool(std::shared_ptr<BundlePrivate> const& bundle)
+    {
+        std::vector<InterfaceMapConstPtr> pool;
+        std::shared_ptr<ServiceFactory> sf;
+        {
+            auto reg = registration.lock();
+            auto l = LockServiceRegistration();
+            US_UNUSED(l);
+            auto poolIter = coreInfo->prototypeServicePool.find(bundle.get());
+            if (!reg || poolIter == coreInfo->prototypeServicePool.end())
+            {
+                return;
+            }
+            pool.swap(poolIter->second);
+            coreInfo->prototypeServicePool.erase(poolIter);
+            sf = std::static_pointer_cast<ServiceFactory>(reg->GetService_unlocked("org.cppmicroservices.factory"));
+        }
+
+        for (auto const& service : pool)
+        {
+            try
+            {
+                sf->UngetService(MakeBundle(bundle), ServiceRegistrationBase(registration.lock()), service);
+            }
+            catch (std::exception const& ex)
+            {
+                SendFactoryExceptionEvent(bundle, ex);
+            }
+        }
+    }
+
+    void
+    ServiceReferenceBasePrivate::SendFactoryExceptionEvent(std::shared_ptr<BundlePrivate> const& bundle,
+                                                           std::exception const& ex)
+    {
+        if (auto bundle_ = coreInfo->bundle_.lock())
+        {
+            std::string message("ServiceFactory threw an exception");
+            bundle_->coreCtx->listeners.SendFrameworkEvent(
+                FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                               MakeBundle(bundle->shared_from_this()),
+                               message,
+                               std::make_exception_ptr(
+                                   ServiceException(ex.what(), ServiceException::Type::FACTORY_EXCEPTION))));
+        }
     }
 
     bool
@@ -385,17 +573,43 @@ namespace cppmicroservices
         InterfaceMapConstPtr sfi;
         std::shared_ptr<ServiceFactory> sf;
 
+        if (!checkRefCounter && coreInfo->prototypePoolSize > 0)
+        {
+            ReleasePrototypeServicePool(bundle);
+        }
+
+        // Fast path for singleton services, see GetServiceInterfaceMap: releasing one of
+        // several uses only decrements the counter and never removes the entry.
+        if (checkRefCounter && !coreInfo->isFactory)
+        {
+            std::shared_lock<std::shared_mutex> dl(coreInfo->dependentsMutex);
+            auto depIter = coreInfo->dependents.find(bundle.get());
+            if (coreInfo->dependents.end() != depIter)
+            {
+                auto& count = depIter->second;
+                int current = count.load();
+                while (current > 1 && !count.compare_exchange_weak(current, current - 1))
+                {
+                }
+                if (current > 1)
+                {
+                    return false;
+                }
+            }
+        }
+
         {
             auto reg = registration.lock();
             auto l = LockServiceRegistration();
             US_UNUSED(l);
+            std::unique_lock<std::shared_mutex> dl(coreInfo->dependentsMutex);
             auto depIter = coreInfo->dependents.find(bundle.get());
             if (coreInfo->dependents.end() == depIter)
             {
                 return hadReferences && removeService;
             }
 
-            int& count = depIter->second;
+            auto& count = depIter->second;
             if (count > 0)
             {
                 hadReferences = true;
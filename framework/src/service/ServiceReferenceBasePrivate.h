@@ -68,7 +68,8 @@ namespace cppmicroservices
         InterfaceMapConstPtr GetServiceInterfaceMap(BundlePrivate* bundle);
 
         /**
-         * Get new service instance.
+         * Get new service instance. If the service pools its prototype instances,
+         * a previously released instance of the bundle is reused if available.
          *
          * @param bundle requester of service.
          * @return Service requested or null in case of failure.
@@ -88,10 +89,13 @@ namespace cppmicroservices
         bool UngetService(std::shared_ptr<BundlePrivate> const& bundle, bool checkRefCounter);
 
         /**
-         * Unget prototype scope service objects.
+         * Unget prototype scope service objects. If the service pools its prototype
+         * instances and the pool of the bundle is not full, the reset service object
+         * is kept for reuse instead of being handed back to the factory.
          *
          * @param bundle Bundle who wants to remove a prototype scope service.
-         * @param service The prototype scope service pointer.
+         * @param service The prototype scope service pointer, as returned by
+         *        GetPrototypeService.
          * @return \c true if the service was removed, \c false otherwise.
          */
         bool UngetPrototypeService(std::shared_ptr<BundlePrivate> const& bundle, InterfaceMapConstPtr const& service);
@@ -121,8 +125,28 @@ namespace cppmicroservices
         std::shared_ptr<ServiceRegistrationCoreInfo> coreInfo;
 
       private:
+        /**
+         * Record in the reverse index of the bundle that it uses this service, see
+         * BundlePrivate::usedServices. Requires the registration locks.
+         *
+         * @param bundle The bundle starting to use the service.
+         */
+        void RecordServiceUse_unlocked(BundlePrivate* bundle);
+
         InterfaceMapConstPtr GetServiceFromFactory(BundlePrivate* bundle,
                                                    std::shared_ptr<ServiceFactory> const& factory);
+
+        /**
+         * Hand the pooled prototype instances of a bundle back to the factory.
+         *
+         * @param bundle The bundle whose pooled instances are released.
+         */
+        void ReleasePrototypeServicePool(std::shared_ptr<BundlePrivate> const& bundle);
+
+        /**
+         * Send a framework error event for an exception thrown by the service factory.
+         */
+        void SendFactoryExceptionEvent(std::shared_ptr<BundlePrivate> const& bundle, std::exception const& ex);
     };
 } // namespace cppmicroservices
 
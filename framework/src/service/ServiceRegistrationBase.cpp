@@ -28,11 +28,14 @@
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
+#include "PropsCheck.h"
 #include "ServiceListenerEntry.h"
 #include "ServiceRegistrationBasePrivate.h"
 #include "ServiceRegistrationLocks.h"
 #include "ServiceRegistry.h"
 
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 
 US_MSVC_DISABLE_WARNING(4503) // decorated name length exceeded, name was truncated
@@ -118,6 +121,13 @@ namespace cppmicroservices
             throw std::logic_error("Service is unregistered");
         }
 
+        // Validate the caller supplied keys up front; the framework keys added below are
+        // only checked against them, so the final map does not need to be validated again.
+        props_check::ValidateServiceProperties(propsCopy);
+        props_check::ValidateAdditionalKey(propsCopy, Constants::SERVICE_ID);
+        props_check::ValidateAdditionalKey(propsCopy, Constants::OBJECTCLASS);
+        props_check::ValidateAdditionalKey(propsCopy, Constants::SERVICE_SCOPE);
+
         {
             auto l = LockServiceRegistration();
             US_UNUSED(l);
@@ -178,7 +188,8 @@ namespace cppmicroservices
                 // stored in the service registry, no need to type check before casting
                 old_rank = any_cast<int>(oldRankAny);
             }
-            d->coreInfo->properties = Properties(AnyMap(std::move(propsCopy)));
+            d->coreInfo->properties = Properties(AnyMap(std::move(propsCopy)), Properties::PreValidated {});
+            d->coreInfo->serviceRanking = new_rank;
         }
         if (old_rank != new_rank)
         {
@@ -265,6 +276,11 @@ namespace cppmicroservices
             if (serviceFactory)
             {
                 prototypeServiceInstances = d->coreInfo->prototypeServiceInstances;
+                // pooled prototype instances are released together with the ones in use
+                for (auto const& pool : d->coreInfo->prototypeServicePool)
+                {
+                    prototypeServiceInstances[pool.first].insert(pool.second.begin(), pool.second.end());
+                }
                 bundleServiceInstance = d->coreInfo->bundleServiceInstance;
             }
         }
@@ -324,9 +340,30 @@ namespace cppmicroservices
             US_UNUSED(l);
 
             d->coreInfo->bundle_.reset();
-            d->coreInfo->dependents.clear();
-            d->coreInfo->service.reset();
+
+            // remove this registration from the reverse index of its users
+            auto forget = [this](BundlePrivate* user)
+            { user->usedServices.Lock(), user->usedServices.v.erase(d.get()); };
+            for (auto const& dependent : d->coreInfo->dependents)
+            {
+                forget(dependent.first);
+            }
+            for (auto const& instances : d->coreInfo->prototypeServiceInstances)
+            {
+                forget(instances.first);
+            }
+            for (auto const& pool : d->coreInfo->prototypeServicePool)
+            {
+                forget(pool.first);
+            }
+
+            {
+                std::unique_lock<std::shared_mutex> dl(d->coreInfo->dependentsMutex);
+                d->coreInfo->dependents.clear();
+                d->coreInfo->service.reset();
+            }
             d->coreInfo->prototypeServiceInstances.clear();
+            d->coreInfo->prototypeServicePool.clear();
             d->coreInfo->bundleServiceInstance.clear();
 
             d->reference = nullptr;
@@ -56,8 +56,15 @@ namespace cppmicroservices
         US_UNUSED(l);
         auto l1 = coreInfo->Lock();
         US_UNUSED(l1);
+        return IsUsedByBundle_unlocked(bundle);
+    }
+
+    bool
+    ServiceRegistrationBasePrivate::IsUsedByBundle_unlocked(BundlePrivate* bundle) const
+    {
         return (coreInfo->dependents.find(bundle) != coreInfo->dependents.end())
-               || (coreInfo->prototypeServiceInstances.find(bundle) != coreInfo->prototypeServiceInstances.end());
+               || (coreInfo->prototypeServiceInstances.find(bundle) != coreInfo->prototypeServiceInstances.end())
+               || (coreInfo->prototypeServicePool.find(bundle) != coreInfo->prototypeServicePool.end());
     }
 
     InterfaceMapConstPtr
@@ -50,9 +50,9 @@ namespace cppmicroservices
         friend class ServiceRegistrationBase;
 
       public:
-        using BundleToRefsMap = std::unordered_map<BundlePrivate*, int>;
-        using BundleToServiceMap = std::unordered_map<BundlePrivate*, InterfaceMapConstPtr>;
-        using BundleToServicesMap = std::unordered_map<BundlePrivate*, std::list<InterfaceMapConstPtr>>;
+        using BundleToRefsMap = ServiceRegistrationCoreInfo::BundleToRefsMap;
+        using BundleToServiceMap = ServiceRegistrationCoreInfo::BundleToServiceMap;
+        using BundleToServicesMap = ServiceRegistrationCoreInfo::BundleToServicesMap;
 
         ServiceRegistrationBasePrivate(ServiceRegistrationBasePrivate const&) = delete;
         ServiceRegistrationBasePrivate& operator=(ServiceRegistrationBasePrivate const&) = delete;
@@ -82,6 +82,8 @@ namespace cppmicroservices
          */
         bool IsUsedByBundle(BundlePrivate* bundle) const;
 
+        bool IsUsedByBundle_unlocked(BundlePrivate* bundle) const;
+
         InterfaceMapConstPtr GetInterfaces() const;
 
         std::shared_ptr<void> GetService(std::string const& interfaceId) const;
@@ -22,6 +22,8 @@
 
 #include "ServiceRegistrationCoreInfo.h"
 
+#include "cppmicroservices/Constants.h"
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4355)
@@ -30,12 +32,44 @@
 namespace cppmicroservices
 {
 
+    namespace
+    {
+        std::size_t
+        PrototypePoolSize(Properties const& props)
+        {
+            if (props.Value_unlocked(Constants::SERVICE_SCOPE).first.ToString() != Constants::SCOPE_PROTOTYPE)
+            {
+                return 0;
+            }
+            auto poolSize = props.Value_unlocked(Constants::SERVICE_PROTOTYPE_POOL_SIZE).first;
+            if (poolSize.Type() != typeid(int) || any_cast<int>(poolSize) <= 0)
+            {
+                return 0;
+            }
+            return static_cast<std::size_t>(any_cast<int>(poolSize));
+        }
+
+        template <class T>
+        T
+        ValueOrDefault(Properties const& props, std::string const& key)
+        {
+            auto value = props.Value_unlocked(key).first;
+            return value.Type() == typeid(T) ? any_cast<T>(value) : T();
+        }
+    } // namespace
+
     ServiceRegistrationCoreInfo::ServiceRegistrationCoreInfo(BundlePrivate* bundle,
                                                              InterfaceMapConstPtr service,
                                                              Properties&& props)
         : service(std::move(service))
+        , isFactory(this->service && this->service->count("org.cppmicroservices.factory") > 0)
+        , prototypePoolSize(PrototypePoolSize(props))
         , bundle_(bundle->shared_from_this())
         , properties(std::move(props))
+        , serviceId(ValueOrDefault<long>(properties, Constants::SERVICE_ID))
+        , serviceRanking(ValueOrDefault<int>(properties, Constants::SERVICE_RANKING))
+        , objectClasses(ValueOrDefault<std::vector<std::string>>(properties, Constants::OBJECTCLASS))
+        , serviceScope(ValueOrDefault<std::string>(properties, Constants::SERVICE_SCOPE))
         , available(true)
         , unregistering(false)
     {
@@ -31,6 +31,11 @@
 #include "Properties.h"
 
 #include <atomic>
+#include <future>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace cppmicroservices
 {
@@ -51,14 +56,21 @@ namespace cppmicroservices
         ServiceRegistrationCoreInfo(ServiceRegistrationCoreInfo const&) = delete;
         ServiceRegistrationCoreInfo& operator=(ServiceRegistrationCoreInfo const&) = delete;
 
-        using BundleToRefsMap = std::unordered_map<BundlePrivate*, int>;
+        using BundleToRefsMap = std::unordered_map<BundlePrivate*, std::atomic<int>>;
         using BundleToServiceMap = std::unordered_map<BundlePrivate*, InterfaceMapConstPtr>;
-        using BundleToServicesMap = std::unordered_map<BundlePrivate*, std::list<InterfaceMapConstPtr>>;
+        using BundleToServicesMap = std::unordered_map<BundlePrivate*, std::unordered_multiset<InterfaceMapConstPtr>>;
+        using BundleToServicePoolMap = std::unordered_map<BundlePrivate*, std::vector<InterfaceMapConstPtr>>;
 
         /**
          * Service or ServiceFactory object.
          */
         InterfaceMapConstPtr service;
+        /**
+         * <code>true</code> if <code>service</code> contains a ServiceFactory, i.e. the
+         * service has bundle or prototype scope.
+         */
+        bool const isFactory;
+
         /**
          * Bundles dependent on this service. Integer is used as
          * reference counter, counting number of unbalanced getService().
@@ -66,15 +78,45 @@ namespace cppmicroservices
         BundleToRefsMap dependents;
 
         /**
-         * Object instances that a prototype factory has produced.
+         * Adding or removing bundles in <code>dependents</code> and resetting
+         * <code>service</code> require this lock exclusively, in addition to the
+         * registration locks. Singleton services adjust the (atomic) counter of a bundle
+         * which already uses the service while holding only a shared lock, so concurrent
+         * GetService/UngetService calls do not serialize on the registration locks.
+         */
+        mutable std::shared_mutex dependentsMutex;
+
+        /**
+         * Object instances that a prototype factory has produced and which are
+         * currently in use.
          */
         BundleToServicesMap prototypeServiceInstances;
 
+        /**
+         * Maximum number of released prototype instances kept per bundle for reuse.
+         * Zero if the service does not pool its prototype instances, see
+         * Constants::SERVICE_PROTOTYPE_POOL_SIZE.
+         */
+        std::size_t const prototypePoolSize;
+
+        /**
+         * Released and reset prototype instances, per bundle, which are handed out
+         * again before the prototype factory is asked for a new instance.
+         */
+        BundleToServicePoolMap prototypeServicePool;
+
         /**
          * Object instance with bundle scope that a factory may have produced.
          */
         BundleToServiceMap bundleServiceInstance;
 
+        /**
+         * Bundle scope instances which a factory is currently producing. Threads
+         * requesting the service for a bundle while its instance is being produced
+         * wait for the result instead of calling the factory again.
+         */
+        std::unordered_map<BundlePrivate*, std::shared_future<InterfaceMapConstPtr>> pendingBundleServiceInstances;
+
         /**
          * Bundle registering this service.
          */
@@ -85,6 +127,16 @@ namespace cppmicroservices
          */
         Properties properties;
 
+        /**
+         * Copies of the framework maintained service properties, so they can be
+         * read without locking <code>properties</code>. The ranking is updated
+         * together with the properties.
+         */
+        long const serviceId;
+        std::atomic<int> serviceRanking;
+        std::vector<std::string> const objectClasses;
+        std::string const serviceScope;
+
         /**
          * Is service available. I.e., if <code>true</code> then holders
          * of a ServiceReference for the service are allowed to get it.
@@ -22,20 +22,42 @@
 
 #include "ServiceRegistry.h"
 
+#include "cppmicroservices/BundleEventHook.h"
+#include "cppmicroservices/BundleFindHook.h"
 #include "cppmicroservices/PrototypeServiceFactory.h"
+#include "cppmicroservices/ServiceEventListenerHook.h"
 #include "cppmicroservices/ServiceFactory.h"
+#include "cppmicroservices/ServiceFindHook.h"
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
+#include "PropsCheck.h"
+#include "ServiceReferenceBasePrivate.h"
 #include "ServiceRegistrationBasePrivate.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace cppmicroservices
 {
 
+    namespace
+    {
+        // service ids increase with each registration
+        void
+        SortByServiceId(std::vector<std::shared_ptr<ServiceRegistrationBasePrivate>>& regs)
+        {
+            std::sort(regs.begin(),
+                      regs.end(),
+                      [](std::shared_ptr<ServiceRegistrationBasePrivate> const& a,
+                         std::shared_ptr<ServiceRegistrationBasePrivate> const& b)
+                      { return a->coreInfo->serviceId < b->coreInfo->serviceId; });
+        }
+    } // namespace
+
     void
     ServiceRegistry::Clear()
     {
@@ -44,6 +66,11 @@ namespace cppmicroservices
         services.clear();
         classServices.clear();
         serviceRegistrations.clear();
+        for (auto& hook : hooks)
+        {
+            hook.regs.Store(nullptr);
+        }
+        hasHooks.store(false, std::memory_order_release);
     }
 
     Properties
@@ -52,17 +79,34 @@ namespace cppmicroservices
                                              bool isFactory,
                                              bool isPrototypeFactory,
                                              long sid)
+    {
+        return CreateServiceProperties(ServiceProperties(in), classes, isFactory, isPrototypeFactory, sid);
+    }
+
+    Properties
+    ServiceRegistry::CreateServiceProperties(ServiceProperties&& in,
+                                             std::vector<std::string> const& classes,
+                                             bool isFactory,
+                                             bool isPrototypeFactory,
+                                             long sid)
     {
         static std::atomic<long> nextServiceID(1);
-        ServiceProperties props(in);
+        ServiceProperties props(std::move(in));
+
+        // Validate the caller supplied keys once, and then only check each framework
+        // key against them while inserting it, rather than validating the final map.
+        props_check::ValidateServiceProperties(props);
 
         if (!classes.empty())
         {
+            props_check::ValidateAdditionalKey(props, Constants::OBJECTCLASS);
             props.insert(std::make_pair(Constants::OBJECTCLASS, classes));
         }
 
+        props_check::ValidateAdditionalKey(props, Constants::SERVICE_ID);
         props.insert(std::make_pair(Constants::SERVICE_ID, sid != -1 ? sid : nextServiceID++));
 
+        props_check::ValidateAdditionalKey(props, Constants::SERVICE_SCOPE);
         if (isPrototypeFactory)
         {
             props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_PROTOTYPE));
@@ -76,21 +120,37 @@ namespace cppmicroservices
             props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_SINGLETON));
         }
 
-        return Properties(AnyMap(std::move(props)));
+        return Properties(AnyMap(std::move(props)), Properties::PreValidated {});
     }
 
-    ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx) : core(coreCtx) {}
+    ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx) : core(coreCtx), hasHooks(false)
+    {
+        hooks[0].clazz = us_service_interface_iid<BundleFindHook>();
+        hooks[1].clazz = us_service_interface_iid<BundleEventHook>();
+        hooks[2].clazz = us_service_interface_iid<ServiceFindHook>();
+        hooks[3].clazz = us_service_interface_iid<ServiceEventListenerHook>();
+    }
 
     ServiceRegistrationBase
     ServiceRegistry::RegisterService(BundlePrivate* bundle,
                                      InterfaceMapConstPtr const& service,
                                      ServiceProperties const& properties)
+    {
+        return RegisterService(bundle, service, ServiceProperties(properties));
+    }
+
+    ServiceRegistrationBase
+    ServiceRegistry::RegisterService(BundlePrivate* bundle,
+                                     InterfaceMapConstPtr const& service,
+                                     ServiceProperties&& properties)
     {
         if (!service || service->empty())
         {
             throw std::invalid_argument("Can't register empty InterfaceMap as a service");
         }
 
+        StartupProfiler::Span span(core->profiler, "RegisterService", "service");
+
         // Check if we got a service factory
         bool isFactory = service->count("org.cppmicroservices.factory") > 0;
         bool isPrototypeFactory
@@ -108,10 +168,20 @@ namespace cppmicroservices
             }
             classes.push_back(i.first);
         }
+        if (span.IsRecording())
+        {
+            span.AddArg("bundle", bundle->symbolicName);
+            std::string objectClass;
+            for (auto const& clazz : classes)
+            {
+                objectClass += (objectClass.empty() ? "" : ", ") + clazz;
+            }
+            span.AddArg("objectclass", objectClass);
+        }
 
         ServiceRegistrationBase res(bundle,
                                     service,
-                                    CreateServiceProperties(properties, classes, isFactory, isPrototypeFactory));
+                                    CreateServiceProperties(std::move(properties), classes, isFactory, isPrototypeFactory));
         {
             auto l = this->Lock();
             US_UNUSED(l);
@@ -123,6 +193,7 @@ namespace cppmicroservices
                 auto ip = std::lower_bound(s.rbegin(), s.rend(), res);
                 s.insert(ip.base(), res);
             }
+            UpdateHooks_unlocked(classes);
         }
 
         ServiceReferenceBase r = res.GetReference(std::string());
@@ -143,6 +214,7 @@ namespace cppmicroservices
             auto& s = classServices[clazz];
             std::sort(s.rbegin(), s.rend());
         }
+        UpdateHooks_unlocked(classes);
     }
 
     void
@@ -291,9 +363,62 @@ namespace cppmicroservices
         RemoveServiceRegistration_unlocked(sr);
     }
 
+    void
+    ServiceRegistry::RemoveServiceRegistrations(std::vector<ServiceRegistrationBase> const& srs)
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+
+        std::unordered_set<ServiceRegistrationBase> removed;
+        std::vector<std::string> classes;
+        for (auto const& sr : srs)
+        {
+            auto iter = services.find(sr);
+            if (iter == services.end())
+            {
+                continue;
+            }
+            classes.insert(classes.end(), iter->second.begin(), iter->second.end());
+            removed.insert(sr);
+            services.erase(iter);
+        }
+        if (removed.empty())
+        {
+            return;
+        }
+
+        auto isRemoved = [&removed](ServiceRegistrationBase const& sr) { return removed.count(sr) != 0; };
+        serviceRegistrations.erase(std::remove_if(serviceRegistrations.begin(), serviceRegistrations.end(), isRemoved),
+                                   serviceRegistrations.end());
+
+        std::sort(classes.begin(), classes.end());
+        classes.erase(std::unique(classes.begin(), classes.end()), classes.end());
+        for (auto const& clazz : classes)
+        {
+            auto iter = classServices.find(clazz);
+            if (iter == classServices.end())
+            {
+                continue;
+            }
+            auto& s = iter->second;
+            s.erase(std::remove_if(s.begin(), s.end(), isRemoved), s.end());
+            if (s.empty())
+            {
+                classServices.erase(iter);
+            }
+        }
+        UpdateHooks_unlocked(classes);
+    }
+
     void
     ServiceRegistry::RemoveServiceRegistration_unlocked(ServiceRegistrationBase const& sr)
     {
+        if (services.find(sr) == services.end())
+        {
+            // Already removed by RemoveServiceRegistrations()
+            return;
+        }
+
         std::vector<std::string> classes;
         {
             auto l2 = sr.d->coreInfo->properties.Lock();
@@ -318,37 +443,154 @@ namespace cppmicroservices
                 classServices.erase(clazz);
             }
         }
+        UpdateHooks_unlocked(classes);
+    }
+
+    std::shared_ptr<ServiceRegistry::ServiceRegistrations const>
+    ServiceRegistry::GetHooks(std::string const& clazz) const
+    {
+        for (auto& hook : hooks)
+        {
+            if (hook.clazz == clazz)
+            {
+                return hook.regs.Load();
+            }
+        }
+        return nullptr;
+    }
+
+    void
+    ServiceRegistry::UpdateHooks_unlocked(std::vector<std::string> const& classes)
+    {
+        bool changed = false;
+        for (auto& hook : hooks)
+        {
+            if (std::find(classes.begin(), classes.end(), hook.clazz) == classes.end())
+            {
+                continue;
+            }
+
+            auto i = classServices.find(hook.clazz);
+            if (i != classServices.end() && !i->second.empty())
+            {
+                hook.regs.Store(std::make_shared<ServiceRegistrations const>(i->second));
+            }
+            else
+            {
+                hook.regs.Store(nullptr);
+            }
+            changed = true;
+        }
+
+        if (changed)
+        {
+            hasHooks.store(std::any_of(hooks.begin(),
+                                       hooks.end(),
+                                       [](HookRegistrations const& hook) { return hook.regs.Load() != nullptr; }),
+                           std::memory_order_release);
+        }
     }
 
     void
     ServiceRegistry::GetRegisteredByBundle(BundlePrivate* p, std::vector<ServiceRegistrationBase>& res) const
     {
+        std::weak_ptr<BundlePrivate> const bundle = p->shared_from_this();
+
         auto l = this->Lock();
         US_UNUSED(l);
 
+        // Compare the owners instead of locking the bundle of each registration
         for (auto& sr : serviceRegistrations)
         {
-            if (auto bundle_ = sr.d->coreInfo->bundle_.lock())
+            auto const& bundle_ = sr.d->coreInfo->bundle_;
+            if (!bundle_.owner_before(bundle) && !bundle.owner_before(bundle_))
             {
-                if (bundle_.get() == p)
+                res.push_back(sr);
+            }
+        }
+    }
+
+    void
+    ServiceRegistry::GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& res) const
+    {
+        std::vector<std::shared_ptr<ServiceRegistrationBasePrivate>> candidates;
+        {
+            auto l = bundle->usedServices.Lock();
+            US_UNUSED(l);
+            auto& used = bundle->usedServices.v;
+            candidates.reserve(used.size());
+            for (auto iter = used.begin(); iter != used.end();)
+            {
+                if (auto reg = iter->second.lock())
                 {
-                    res.push_back(sr);
+                    candidates.push_back(std::move(reg));
+                    ++iter;
                 }
+                else
+                {
+                    iter = used.erase(iter);
+                }
+            }
+        }
+
+        SortByServiceId(candidates);
+
+        for (auto& reg : candidates)
+        {
+            auto l = reg->Lock();
+            US_UNUSED(l);
+            auto l1 = reg->coreInfo->Lock();
+            US_UNUSED(l1);
+            if (!reg->IsUsedByBundle_unlocked(bundle))
+            {
+                // the bundle stopped using the service since it was recorded
+                bundle->usedServices.Lock(), bundle->usedServices.v.erase(reg.get());
+            }
+            else if (reg->coreInfo->available)
+            {
+                res.push_back(ServiceRegistrationBase(reg));
             }
         }
     }
 
     void
-    ServiceRegistry::GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& res) const
+    ServiceRegistry::UngetServicesUsedByBundle(BundlePrivate* bundle)
     {
-        auto l = this->Lock();
-        US_UNUSED(l);
+        decltype(bundle->usedServices.v) used;
+        {
+            auto l = bundle->usedServices.Lock();
+            US_UNUSED(l);
+            used.swap(bundle->usedServices.v);
+        }
 
-        for (auto const& serviceRegistration : serviceRegistrations)
+        // release the services in registration order, independent of the hash
+        // order of the reverse index
+        std::vector<std::shared_ptr<ServiceRegistrationBasePrivate>> regs;
+        regs.reserve(used.size());
+        for (auto const& entry : used)
         {
-            if (serviceRegistration.d->IsUsedByBundle(bundle))
+            // an unregistered service has already been released by Unregister()
+            if (auto reg = entry.second.lock(); reg && reg->coreInfo->available)
+            {
+                regs.push_back(std::move(reg));
+            }
+        }
+        SortByServiceId(regs);
+
+        auto b = bundle->shared_from_this();
+        for (auto const& reg : regs)
+        {
+            try
+            {
+                auto ref = ServiceRegistrationBase(reg).GetReference(std::string());
+                ref.d.Load()->UngetService(b, false);
+            }
+            catch (...)
             {
-                res.push_back(serviceRegistration);
+                core->logger->Log(logservice::SeverityLevel::LOG_WARNING,
+                                  "Some services already unregistered in Bundle " + bundle->symbolicName
+                                      + " (location=" + bundle->location + ")",
+                                  std::current_exception());
             }
         }
     }
@@ -27,6 +27,9 @@
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include <array>
+#include <atomic>
+
 namespace cppmicroservices
 {
 
@@ -58,8 +61,21 @@ namespace cppmicroservices
                                                   bool isPrototypeFactory = false,
                                                   long sid = -1);
 
+        /**
+         * Same as CreateServiceProperties(ServiceProperties const&, ...), but takes
+         * ownership of <code>in</code>. The caller supplied keys are validated once and
+         * the framework keys are added to the same map, which then becomes the storage of
+         * the returned Properties object without any further copy or validation.
+         */
+        static Properties CreateServiceProperties(ServiceProperties&& in,
+                                                  std::vector<std::string> const& classes = std::vector<std::string>(),
+                                                  bool isFactory = false,
+                                                  bool isPrototypeFactory = false,
+                                                  long sid = -1);
+
         using MapServiceClasses = std::unordered_map<ServiceRegistrationBase, std::vector<std::string>>;
         using MapClassServices = std::unordered_map<std::string, std::vector<ServiceRegistrationBase>>;
+        using ServiceRegistrations = std::vector<ServiceRegistrationBase>;
 
         /**
          * All registered services in the current framework.
@@ -103,6 +119,14 @@ namespace cppmicroservices
                                                 InterfaceMapConstPtr const& service,
                                                 ServiceProperties const& properties);
 
+        /**
+         * Same as RegisterService(BundlePrivate*, InterfaceMapConstPtr const&, ServiceProperties const&),
+         * but moves <code>properties</code> into the registration instead of copying them.
+         */
+        ServiceRegistrationBase RegisterService(BundlePrivate* bundle,
+                                                InterfaceMapConstPtr const& service,
+                                                ServiceProperties&& properties);
+
         /**
          * Reorder registered services. Call this method if the ranking for
          * a service registration has changed
@@ -150,6 +174,15 @@ namespace cppmicroservices
          */
         void RemoveServiceRegistration(ServiceRegistrationBase const& sr);
 
+        /**
+         * Remove several registered services at once. The registrations stay
+         * valid and must still be unregistered, which then only notifies the
+         * service listeners and releases the service objects.
+         *
+         * @param srs The ServiceRegistration objects to remove.
+         */
+        void RemoveServiceRegistrations(std::vector<ServiceRegistrationBase> const& srs);
+
         /**
          * Get all services that a bundle has registered.
          *
@@ -159,19 +192,61 @@ namespace cppmicroservices
         void GetRegisteredByBundle(BundlePrivate* m, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
         /**
-         * Get all services that a bundle uses.
+         * Get all services that a bundle uses, in registration order. Only the
+         * registrations in the reverse index of the bundle are checked.
          *
          * @param bundle The bundle
          * @return A set of {@link ServiceRegistration} objects
          */
         void GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+        /**
+         * Release all services that a bundle uses, in a single pass over the
+         * reverse index of the bundle, which is emptied.
+         *
+         * @param bundle The bundle
+         */
+        void UngetServicesUsedByBundle(BundlePrivate* bundle);
+
+        /**
+         * Check if any BundleFindHook, BundleEventHook, ServiceFindHook or
+         * ServiceEventListenerHook is registered. Hook processing can be
+         * skipped entirely if not.
+         */
+        bool
+        HasHooks() const
+        {
+            return hasHooks.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Get the registrations of one of the hook interfaces listed for
+         * HasHooks(), ordered with the highest ranked service first. The
+         * snapshot is only replaced when such a service is registered,
+         * unregistered or re-ranked, so this neither locks nor copies.
+         *
+         * @param clazz The class name of the hook interface.
+         * @return The snapshot, or nullptr if no such hook is registered.
+         */
+        std::shared_ptr<ServiceRegistrations const> GetHooks(std::string const& clazz) const;
+
       private:
         friend class ServiceHooks;
         friend class ServiceRegistrationBase;
 
         void RemoveServiceRegistration_unlocked(ServiceRegistrationBase const& sr);
 
+        void UpdateHooks_unlocked(std::vector<std::string> const& classes);
+
+        struct HookRegistrations
+        {
+            std::string clazz;
+            detail::Atomic<std::shared_ptr<ServiceRegistrations const>> regs;
+        };
+
+        std::array<HookRegistrations, 4> hooks;
+        std::atomic<bool> hasHooks;
+
         void Get_unlocked(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
         void Get_unlocked(std::string const& clazz,
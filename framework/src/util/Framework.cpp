@@ -24,6 +24,7 @@
 
 #include "cppmicroservices/FrameworkEvent.h"
 
+#include "BundleStartScheduler.h"
 #include "FrameworkPrivate.h"
 
 namespace cppmicroservices
@@ -73,4 +74,29 @@ namespace cppmicroservices
     {
         return pimpl(d)->WaitForStop(timeout);
     }
+
+    void
+    Framework::StartBundles(std::vector<Bundle> const& bundles, uint32_t options)
+    {
+        auto const errors = BundleStartScheduler(bundles).Run(options);
+        for (auto const& e : errors)
+        {
+            if (e)
+            {
+                std::rethrow_exception(e);
+            }
+        }
+    }
+
+    int
+    Framework::GetStartLevel() const
+    {
+        return pimpl(d)->coreCtx->activeStartLevel;
+    }
+
+    void
+    Framework::SetStartLevel(int startLevel)
+    {
+        pimpl(d)->SetStartLevel(startLevel);
+    }
 } // namespace cppmicroservices
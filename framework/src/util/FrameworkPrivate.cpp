@@ -26,16 +26,63 @@ limitations under the License.
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 
+#include "BundleArchive.h"
 #include "BundleContextPrivate.h"
+#include "BundleStartScheduler.h"
 #include "BundleStorage.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <sstream>
 
 namespace cppmicroservices
 {
 
+    namespace
+    {
+        // The beginning start level may be given as an integer or as a string.
+        // Like in OSGi, values which are not positive integers are ignored.
+        int
+        GetBeginningStartLevel(std::unordered_map<std::string, Any> const& properties)
+        {
+            int level = 1;
+            auto const& value = properties.at(Constants::FRAMEWORK_BEGINNING_STARTLEVEL);
+            if (value.Type() == typeid(int))
+            {
+                level = ref_any_cast<int>(value);
+            }
+            else if (value.Type() == typeid(std::string))
+            {
+                std::istringstream is(ref_any_cast<std::string>(value));
+                if (!(is >> level) || !is.eof())
+                {
+                    level = 1;
+                }
+            }
+            return level < 1 ? 1 : level;
+        }
+
+        // Sets a flag for the lifetime of the scope, also if it is left by an
+        // exception.
+        class FlagScope
+        {
+          public:
+            explicit FlagScope(std::atomic<bool>& flag) : flag(flag) { flag = true; }
+            ~FlagScope() { flag = false; }
+
+            FlagScope(FlagScope const&) = delete;
+            FlagScope& operator=(FlagScope const&) = delete;
+
+          private:
+            std::atomic<bool>& flag;
+        };
+    } // namespace
+
     FrameworkPrivate::FrameworkPrivate(CoreBundleContext* fwCtx)
         : BundlePrivate(fwCtx)
+        , requestedStartLevel(0)
+        , startLevelChanging(false)
         , headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
     {
         headers[Constants::BUNDLE_SYMBOLICNAME] = symbolicName;
@@ -179,7 +226,6 @@ namespace cppmicroservices
     void
     FrameworkPrivate::Start(uint32_t)
     {
-        std::vector<long> bundlesToStart;
         {
             auto l = Lock();
             US_UNUSED(l);
@@ -202,49 +248,248 @@ namespace cppmicroservices
 
                     throw std::runtime_error("INTERNAL ERROR, Illegal state, " + ss.str());
             }
-            bundlesToStart = coreCtx->storage->GetStartOnLaunchBundles();
+            requestedStartLevel = GetBeginningStartLevel(coreCtx->frameworkProperties);
+            startLevelChanging = true;
         }
 
-        // Start bundles according to their autostart setting.
-        for (auto i : bundlesToStart)
+        // Start bundles according to their autostart setting, level by level
+        // up to the beginning start level.
         {
-            auto b = coreCtx->bundleRegistry->GetBundle(i);
-            try
+            StartupProfiler::Span span(coreCtx->profiler, "Framework::Start", "framework");
+            ChangeStartLevel(false);
+        }
+
+        {
+            auto l = Lock();
+            US_UNUSED(l);
+
+            if (state == Bundle::STATE_ACTIVE)
+            {
+                return;
+            }
+
+            state = Bundle::STATE_ACTIVE;
+            operation = BundlePrivate::OP_IDLE;
+        }
+
+        // Start-up is complete, stop recording the start-up timeline.
+        coreCtx->CloseStartupTrace();
+
+        coreCtx->listeners.SendFrameworkEvent(
+            FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTED, MakeBundle(shared_from_this()), std::string()));
+    }
+
+    void
+    FrameworkPrivate::SetStartLevel(int startLevel)
+    {
+        if (startLevel < 1)
+        {
+            throw std::invalid_argument("The start level must be a positive integer");
+        }
+
+        {
+            auto l = Lock();
+            US_UNUSED(l);
+            if (state != Bundle::STATE_ACTIVE)
+            {
+                throw std::logic_error("The start level can only be changed while the framework is active");
+            }
+            requestedStartLevel = startLevel;
+            if (startLevelChanging)
+            {
+                // The running change picks up the new start level.
+                return;
+            }
+            startLevelChanging = true;
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+            // Start level changes run one at a time: a previous change is done
+            // once startLevelChanging was reset, so joining it does not block.
+            // Shutting down the framework joins the running change.
+            if (startLevelThread.joinable())
+            {
+                startLevelThread.join();
+            }
+            startLevelThread = std::thread(std::bind(&FrameworkPrivate::ChangeStartLevel, this, true));
+#endif
+        }
+
+#ifndef US_ENABLE_THREADING_SUPPORT
+        ChangeStartLevel(true);
+#endif
+    }
+
+    void
+    FrameworkPrivate::ChangeStartLevel(bool reportTarget)
+    {
+        while (true)
+        {
+            int target = 0;
+            int active = 0;
+            {
+                auto l = Lock();
+                US_UNUSED(l);
+                active = coreCtx->activeStartLevel;
+                if (((Bundle::STATE_STARTING | Bundle::STATE_ACTIVE) & state) == 0 || requestedStartLevel == active)
+                {
+                    startLevelChanging = false;
+                    return;
+                }
+                target = requestedStartLevel;
+            }
+
+            auto const begin = std::chrono::steady_clock::now();
+            std::size_t count = 0;
+            int const reached
+                = target > active ? RaiseStartLevel(active, target, count) : LowerStartLevel(active, target, count);
+            auto const elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin);
+
             {
-                int32_t const autostartSetting = b->barchive->GetAutostartSetting();
-                // Launch must not change the autostart setting of a bundle
-                int option = Bundle::START_TRANSIENT;
-                if (Bundle::START_ACTIVATION_POLICY == autostartSetting)
+                auto l = Lock();
+                US_UNUSED(l);
+                if (((Bundle::STATE_STARTING | Bundle::STATE_ACTIVE) & state) == 0)
                 {
-                    // Transient start according to the bundles activation policy.
-                    option |= Bundle::START_ACTIVATION_POLICY;
+                    startLevelChanging = false;
+                    return;
                 }
-                b->Start(option);
+                coreCtx->activeStartLevel = reached;
+            }
+
+            if (count > 0 || (reportTarget && reached == target))
+            {
+                std::ostringstream msg;
+                msg << "Start level " << reached << " reached in " << elapsed.count() << " ms, " << count
+                    << (target > active ? " bundle(s) started" : " bundle(s) stopped");
+                coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED,
+                                                                     MakeBundle(shared_from_this()),
+                                                                     msg.str()));
+            }
+        }
+    }
+
+    int
+    FrameworkPrivate::RaiseStartLevel(int active, int target, std::size_t& count)
+    {
+        int level = target;
+        std::vector<Bundle> bundles;
+        for (auto id : coreCtx->storage->GetStartOnLaunchBundles())
+        {
+            auto b = coreCtx->bundleRegistry->GetBundle(id);
+            if (!b || b->startLevel <= active || b->startLevel > level || b->state == Bundle::STATE_ACTIVE)
+            {
+                continue;
+            }
+            if (b->startLevel < level)
+            {
+                level = b->startLevel;
+                bundles.clear();
+            }
+            bundles.push_back(MakeBundle(b));
+        }
+
+        auto start = [](Bundle& bundle)
+        {
+            int32_t const autostartSetting = GetPrivate(bundle)->barchive->GetAutostartSetting();
+            // Changing the start level must not change the autostart setting of a bundle
+            uint32_t option = Bundle::START_TRANSIENT;
+            if (Bundle::START_ACTIVATION_POLICY == autostartSetting)
+            {
+                // Transient start according to the bundles activation policy.
+                option |= Bundle::START_ACTIVATION_POLICY;
+            }
+            bundle.Start(option);
+        };
+
+        std::vector<std::exception_ptr> errors;
+        bool startConcurrently
+            = any_cast<bool>(coreCtx->frameworkProperties.at(Constants::FRAMEWORK_STARTLEVEL_CONCURRENT));
+        if (startConcurrently)
+        {
+            try
+            {
+                errors = BundleStartScheduler(bundles).Run(start);
             }
             catch (...)
             {
+                // Invalid start dependencies, start the bundles one after the other.
                 coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                                                                     MakeBundle(b->shared_from_this()),
+                                                                     MakeBundle(shared_from_this()),
                                                                      std::string(),
                                                                      std::current_exception()));
+                startConcurrently = false;
             }
         }
-
+        if (!startConcurrently)
         {
-            auto l = Lock();
-            US_UNUSED(l);
+            for (auto& bundle : bundles)
+            {
+                try
+                {
+                    start(bundle);
+                }
+                catch (...)
+                {
+                    coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                                         bundle,
+                                                                         std::string(),
+                                                                         std::current_exception()));
+                }
+            }
+        }
 
-            if (state == Bundle::STATE_ACTIVE)
+        for (std::size_t i = 0; i < errors.size(); ++i)
+        {
+            if (errors[i])
             {
-                return;
+                coreCtx->listeners.SendFrameworkEvent(
+                    FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR, bundles[i], std::string(), errors[i]));
             }
+        }
+        count = bundles.size();
+        return level;
+    }
 
-            state = Bundle::STATE_ACTIVE;
-            operation = BundlePrivate::OP_IDLE;
+    int
+    FrameworkPrivate::LowerStartLevel(int active, int target, std::size_t& count)
+    {
+        int level = target;
+        std::vector<std::shared_ptr<BundlePrivate>> bundles;
+        for (auto const& b : coreCtx->bundleRegistry->GetActiveBundles())
+        {
+            if (b->id == 0 || b->startLevel > active || b->startLevel < level || b->startLevel == target)
+            {
+                continue;
+            }
+            if (b->startLevel > level)
+            {
+                level = b->startLevel;
+                bundles.clear();
+            }
+            bundles.push_back(b);
         }
 
-        coreCtx->listeners.SendFrameworkEvent(
-            FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTED, MakeBundle(shared_from_this()), std::string()));
+        // Stop the bundles of one start level in reverse bundle ID order
+        std::sort(bundles.begin(),
+                  bundles.end(),
+                  [](std::shared_ptr<BundlePrivate> const& a, std::shared_ptr<BundlePrivate> const& b)
+                  { return a->id > b->id; });
+        for (auto const& b : bundles)
+        {
+            try
+            {
+                // Stop bundle without changing its autostart setting.
+                b->Stop(Bundle::StopOptions::STOP_TRANSIENT);
+            }
+            catch (...)
+            {
+                coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                                     MakeBundle(b),
+                                                                     std::string(),
+                                                                     std::current_exception()));
+            }
+        }
+        count = bundles.size();
+        return bundles.empty() ? target : level - 1;
     }
 
     void
@@ -284,12 +529,21 @@ namespace cppmicroservices
                 operation = OP_DEACTIVATING;
                 state = Bundle::STATE_STOPPING;
             }
+#ifdef US_ENABLE_THREADING_SUPPORT
+            // A running start level change returns once it sees the stopping
+            // state, and no new one can be requested any more.
+            if (startLevelThread.joinable())
+            {
+                startLevelThread.join();
+            }
+#endif
             coreCtx->listeners.BundleChanged(
                 BundleEvent(BundleEvent::BUNDLE_STOPPING, MakeBundle(this->shared_from_this())));
             if (wasActive)
             {
                 StopAllBundles();
             }
+            coreCtx->activeStartLevel = 0;
             {
                 auto lock = coreCtx->SetFrameworkStateAndBlockUntilComplete(true);
                 coreCtx->Uninit0();
@@ -333,26 +587,48 @@ namespace cppmicroservices
     void
     FrameworkPrivate::StopAllBundles()
     {
-        // Stop all active bundles, in reverse bundle ID order
+        // Stop all active bundles, in decreasing start level and reverse bundle ID order
         auto activeBundles = coreCtx->bundleRegistry->GetActiveBundles();
-        for (auto iter = activeBundles.rbegin(); iter != activeBundles.rend(); ++iter)
+        std::stable_sort(activeBundles.begin(),
+                         activeBundles.end(),
+                         [](std::shared_ptr<BundlePrivate> const& a, std::shared_ptr<BundlePrivate> const& b)
+                         { return a->startLevel < b->startLevel; });
+
+        if (any_cast<bool>(coreCtx->frameworkProperties.at(Constants::FRAMEWORK_FAST_SHUTDOWN)))
         {
-            auto b = *iter;
-            try
+            FlagScope fastShutdown(coreCtx->fastShutdown);
+            for (auto last = activeBundles.rbegin(); last != activeBundles.rend();)
             {
-                if (((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b->state) != 0)
-                {
-                    // Stop bundle without changing its autostart setting.
-                    b->Stop(Bundle::StopOptions::STOP_TRANSIENT);
-                }
+                auto const level = (*last)->startLevel;
+                auto first = std::find_if(last,
+                                          activeBundles.rend(),
+                                          [level](std::shared_ptr<BundlePrivate> const& b)
+                                          { return b->startLevel != level; });
+                StopBundlesConcurrently(std::vector<std::shared_ptr<BundlePrivate>>(last, first));
+                last = first;
             }
-            catch (...)
+        }
+        else
+        {
+            for (auto iter = activeBundles.rbegin(); iter != activeBundles.rend(); ++iter)
             {
-                coreCtx->listeners.SendFrameworkEvent(
-                    FrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                                                  MakeBundle(b),
-                                                  std::string(),
-                                                  std::current_exception())));
+                auto b = *iter;
+                try
+                {
+                    if (((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b->state) != 0)
+                    {
+                        // Stop bundle without changing its autostart setting.
+                        b->Stop(Bundle::StopOptions::STOP_TRANSIENT);
+                    }
+                }
+                catch (...)
+                {
+                    coreCtx->listeners.SendFrameworkEvent(
+                        FrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                      MakeBundle(b),
+                                                      std::string(),
+                                                      std::current_exception())));
+                }
             }
         }
 
@@ -370,6 +646,57 @@ namespace cppmicroservices
         }
     }
 
+    void
+    FrameworkPrivate::StopBundlesConcurrently(std::vector<std::shared_ptr<BundlePrivate>> const& bundles)
+    {
+        std::vector<Bundle> toStop;
+        for (auto const& b : bundles)
+        {
+            if (((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b->state) != 0)
+            {
+                toStop.push_back(MakeBundle(b));
+            }
+        }
+
+        // Stop bundle without changing its autostart setting.
+        auto stop = [](Bundle& bundle) { bundle.Stop(Bundle::StopOptions::STOP_TRANSIENT); };
+
+        std::vector<std::exception_ptr> errors;
+        try
+        {
+            errors = BundleStartScheduler(toStop).RunReverse(stop);
+        }
+        catch (...)
+        {
+            // Invalid start dependencies, stop the bundles one after the other.
+            coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                                 MakeBundle(shared_from_this()),
+                                                                 std::string(),
+                                                                 std::current_exception()));
+            errors.resize(toStop.size());
+            for (std::size_t i = 0; i < toStop.size(); ++i)
+            {
+                try
+                {
+                    stop(toStop[i]);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < toStop.size(); ++i)
+        {
+            if (errors[i])
+            {
+                coreCtx->listeners.SendFrameworkEvent(
+                    FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR, toStop[i], std::string(), errors[i]));
+            }
+        }
+    }
+
     void
     FrameworkPrivate::SystemShuttingdownDone_unlocked(FrameworkEventInternal const& fe)
     {
@@ -60,6 +60,25 @@ namespace cppmicroservices
         void Start(uint32_t) override;
         void Stop(uint32_t) override;
 
+        /**
+         * Request the framework to move to a new start level. The start level
+         * is changed by a separate thread if threading support is enabled, and
+         * by at most one thread at a time.
+         */
+        void SetStartLevel(int startLevel);
+
+        /**
+         * Move the framework towards the requested start level, one start level
+         * containing bundles at a time, until it is reached or the framework
+         * stops. Bundles of one start level are started one after the other,
+         * or concurrently if Constants::FRAMEWORK_STARTLEVEL_CONCURRENT is set.
+         *
+         * @param reportTarget Whether to send a FRAMEWORK_STARTLEVEL_CHANGED
+         *        event for the requested start level when no bundle had to be
+         *        started or stopped to reach it.
+         */
+        void ChangeStartLevel(bool reportTarget);
+
         void Uninstall() override;
         std::string GetLocation() const override;
 
@@ -96,6 +115,12 @@ namespace cppmicroservices
          */
         void StopAllBundles();
 
+        /**
+         * Stop the given active bundles of one start level concurrently, in
+         * reverse start dependency order. Used by the fast shutdown mode.
+         */
+        void StopBundlesConcurrently(std::vector<std::shared_ptr<BundlePrivate>> const& bundles);
+
         /**
          * The event to return to callers waiting in Framework.waitForStop() when the
          * framework has been stopped.
@@ -118,7 +143,36 @@ namespace cppmicroservices
          */
         std::thread shutdownThread;
 
+        /**
+         * The thread that performs the start level change requested by the last
+         * SetStartLevel call. Joined on shutdown.
+         */
+        std::thread startLevelThread;
+
+        /**
+         * The start level the framework is moving to and whether a thread is
+         * currently changing the start level. Guarded by the framework lock.
+         */
+        int requestedStartLevel;
+        bool startLevelChanging;
+
       private:
+        /**
+         * Start the bundles of the lowest start level above \c active and not
+         * above \c target containing bundles marked to be started.
+         *
+         * @return The start level reached.
+         */
+        int RaiseStartLevel(int active, int target, std::size_t& count);
+
+        /**
+         * Stop the active bundles of the highest start level not above \c active
+         * and above \c target.
+         *
+         * @return The start level reached.
+         */
+        int LowerStartLevel(int active, int target, std::size_t& count);
+
         AnyMap headers;
     };
 } // namespace cppmicroservices
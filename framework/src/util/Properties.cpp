@@ -86,6 +86,8 @@ namespace cppmicroservices
         }
     }
 
+    Properties::Properties(AnyMap&& p, PreValidated) noexcept : props(std::move(p)) {}
+
     Properties::Properties(Properties&& o) noexcept : props(std::move(o.props)) {}
 
     Properties&
@@ -41,6 +41,20 @@ namespace cppmicroservices
         explicit Properties(AnyMap const& props);
         explicit Properties(AnyMap&& props);
 
+        /**
+         * Tag type selecting the constructor for property maps whose keys have already
+         * been checked with the props_check functions.
+         */
+        struct PreValidated
+        {
+        };
+
+        /**
+         * Takes ownership of \c props without validating its keys again. Callers must
+         * have validated \c props, e.g. with props_check::ValidateServiceProperties().
+         */
+        Properties(AnyMap&& props, PreValidated) noexcept;
+
         Properties(Properties&& o) noexcept;
         Properties& operator=(Properties&& o) noexcept;
 
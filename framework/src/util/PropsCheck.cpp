@@ -22,6 +22,10 @@
 
 #include "PropsCheck.h"
 
+#include <algorithm>
+#include <cctype>
+#include <string>
+
 namespace cppmicroservices
 {
     namespace props_check
@@ -31,6 +35,85 @@ namespace cppmicroservices
             const Any emptyAny;
         }
 
+        namespace
+        {
+            void
+            ThrowCaseVariant(std::string_view key)
+            {
+                std::string msg("Properties contain case variants of the key: ");
+                msg += key;
+                throw std::runtime_error(msg.c_str());
+            }
+
+            bool
+            IsCaseVariant(std::string_view l, std::string_view r)
+            {
+                return l.size() == r.size() && ci_compare(l.data(), r.data(), l.size()) == 0;
+            }
+
+            // Below this many keys, comparing every pair of keys is faster than
+            // sorting them, see the RegisterServiceWithProperties benchmark.
+            constexpr std::size_t PairwiseValidationMaxKeys = 16;
+
+            void
+            ValidateKeys(std::vector<std::string_view>& keys)
+            {
+                if (keys.size() < 2)
+                {
+                    return;
+                }
+
+                if (keys.size() < PairwiseValidationMaxKeys)
+                {
+                    // NOTE: A solution involving iterations rather than "raw for-loops" was previously
+                    // tested but ended up being slower than the solution below.
+                    for (uint32_t i = 0; i < keys.size() - 1; ++i)
+                    {
+                        for (uint32_t j = i + 1; j < keys.size(); ++j)
+                        {
+                            if (IsCaseVariant(keys[i], keys[j]))
+                            {
+                                ThrowCaseVariant(keys[i]);
+                            }
+                        }
+                    }
+                    return;
+                }
+
+                // Case variants are adjacent once the keys are sorted case-insensitively.
+                std::sort(keys.begin(),
+                          keys.end(),
+                          [](std::string_view l, std::string_view r)
+                          {
+                              if (l.size() != r.size())
+                              {
+                                  return l.size() < r.size();
+                              }
+                              return ci_compare(l.data(), r.data(), l.size()) < 0;
+                          });
+                for (std::size_t i = 1; i < keys.size(); ++i)
+                {
+                    if (IsCaseVariant(keys[i - 1], keys[i]))
+                    {
+                        ThrowCaseVariant(keys[i - 1]);
+                    }
+                }
+            }
+
+            template <class Map>
+            void
+            ValidateMapKeys(Map const& m)
+            {
+                std::vector<std::string_view> keys(m.size());
+                uint32_t currIndex = 0;
+                for (auto& kv_pair : m)
+                {
+                    keys[currIndex++] = kv_pair.first;
+                }
+                ValidateKeys(keys);
+            }
+        } // namespace
+
         /**
          * @brief Validates that the provided AnyMap conforms to the same constraints that
          * those stored in Property objects have.
@@ -45,29 +128,23 @@ namespace cppmicroservices
         void
         ValidateAnyMap(cppmicroservices::AnyMap const& am)
         {
-            std::vector<std::string_view> keys(am.size());
-            uint32_t currIndex = 0;
-            for (auto& kv_pair : am)
-            {
-                keys[currIndex++] = kv_pair.first;
-            }
+            ValidateMapKeys(am);
+        }
+
+        void
+        ValidateServiceProperties(cppmicroservices::ServiceProperties const& props)
+        {
+            ValidateMapKeys(props);
+        }
 
-            if (am.size() > 1)
+        void
+        ValidateAdditionalKey(cppmicroservices::ServiceProperties const& props, std::string const& key)
+        {
+            for (auto const& kv_pair : props)
             {
-                // NOTE: A solution involving iterations rather than "raw for-loops" was previously
-                // tested but ended up being slower than the solution below.
-                for (uint32_t i = 0; i < keys.size() - 1; ++i)
+                if (IsCaseVariant(kv_pair.first, key) && kv_pair.first != key)
                 {
-                    for (uint32_t j = i + 1; j < keys.size(); ++j)
-                    {
-                        if (keys[i].size() == keys[j].size()
-                            && ci_compare(keys[i].data(), keys[j].data(), keys[i].size()) == 0)
-                        {
-                            std::string msg("Properties contain case variants of the key: ");
-                            msg += keys[i];
-                            throw std::runtime_error(msg.c_str());
-                        }
-                    }
+                    ThrowCaseVariant(kv_pair.first);
                 }
             }
         }
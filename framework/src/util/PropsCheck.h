@@ -44,6 +44,7 @@
 
 #include "cppmicroservices/AnyMap.h"
 #include "cppmicroservices/LDAPFilter.h"
+#include "cppmicroservices/ServiceProperties.h"
 
 #ifdef US_PLATFORM_WINDOWS
 #    include <string.h>
@@ -71,6 +72,32 @@ namespace cppmicroservices
          */
         void ValidateAnyMap(cppmicroservices::AnyMap const& am);
 
+        /**
+         * @brief Validates a ServiceProperties map before it is moved into the AnyMap
+         * of a Properties object.
+         *
+         * Performs the same check as ValidateAnyMap() so that callers which build the
+         * final property map themselves can validate the caller supplied keys once and
+         * hand the result to Properties without it being validated again.
+         *
+         * @param props The ServiceProperties to validate
+         * @throws std::runtime_error Thrown when `props` contains case variants of a key
+         */
+        void ValidateServiceProperties(cppmicroservices::ServiceProperties const& props);
+
+        /**
+         * @brief Validates that `key` can be added to the already valid `props`.
+         *
+         * Adding `key` keeps `props` valid if `props` contains no other key which differs
+         * from `key` in case only. This is a single O(n) pass, as opposed to re-validating
+         * the whole map after the insertion.
+         *
+         * @param props A valid ServiceProperties map
+         * @param key The key which is about to be inserted into or assigned in `props`
+         * @throws std::runtime_error Thrown when `props` contains a case variant of `key`
+         */
+        void ValidateAdditionalKey(cppmicroservices::ServiceProperties const& props, std::string const& key);
+
         std::string ToLower(std::string const& s);
     } // namespace props_check
 } // namespace cppmicroservices
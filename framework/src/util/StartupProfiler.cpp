@@ -0,0 +1,183 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "StartupProfiler.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace cppmicroservices
+{
+
+    namespace
+    {
+
+        void
+        WriteJsonString(std::ostream& os, std::string const& str)
+        {
+            os << '"';
+            for (char c : str)
+            {
+                switch (c)
+                {
+                    case '"':
+                        os << "\\\"";
+                        break;
+                    case '\\':
+                        os << "\\\\";
+                        break;
+                    case '\n':
+                        os << "\\n";
+                        break;
+                    case '\t':
+                        os << "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                               << static_cast<int>(c) << std::dec << std::setfill(' ');
+                        }
+                        else
+                        {
+                            os << c;
+                        }
+                }
+            }
+            os << '"';
+        }
+
+        double
+        ToMicroseconds(StartupProfiler::Clock::duration d)
+        {
+            return std::chrono::duration<double, std::micro>(d).count();
+        }
+
+    } // namespace
+
+    StartupProfiler::Span::Span(StartupProfiler& profiler, char const* name, char const* category)
+        : profiler(profiler.IsOpen() ? &profiler : nullptr)
+        , name(name)
+        , category(category)
+        , begin(this->profiler ? Clock::now() : Clock::time_point())
+    {
+    }
+
+    StartupProfiler::Span::~Span()
+    {
+        if (profiler)
+        {
+            profiler->Record(Event { name, category, begin, Clock::now(), std::this_thread::get_id(), std::move(args) });
+        }
+    }
+
+    void
+    StartupProfiler::Span::AddArg(char const* key, std::string const& value)
+    {
+        if (profiler)
+        {
+            args.emplace_back(key, value);
+        }
+    }
+
+    StartupProfiler::StartupProfiler() : open(false) {}
+
+    void
+    StartupProfiler::Open(std::string const& path)
+    {
+        if (path.empty())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        tracePath = path;
+        origin = Clock::now();
+        events.clear();
+        open.store(true, std::memory_order_release);
+    }
+
+    void
+    StartupProfiler::Close()
+    {
+        if (!open.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        std::ofstream os(tracePath, std::ios_base::trunc);
+        WriteTrace(os);
+        if (!os)
+        {
+            throw std::runtime_error("Failed to write the start-up trace to " + tracePath);
+        }
+    }
+
+    void
+    StartupProfiler::Record(Event&& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Drop spans which ended after the trace was written.
+        if (IsOpen())
+        {
+            events.push_back(std::move(event));
+        }
+    }
+
+    void
+    StartupProfiler::WriteTrace(std::ostream& os) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Number the threads in the order they were first seen, the trace
+        // viewers expect small integer thread ids.
+        std::unordered_map<std::thread::id, std::size_t> threadIds;
+
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        os << std::fixed << std::setprecision(3);
+        bool first = true;
+        for (auto const& event : events)
+        {
+            auto const tid = threadIds.emplace(event.thread, threadIds.size() + 1).first->second;
+
+            os << (first ? "\n" : ",\n");
+            first = false;
+            os << "{\"name\":";
+            WriteJsonString(os, event.name);
+            os << ",\"cat\":";
+            WriteJsonString(os, event.category);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << ToMicroseconds(event.begin - origin)
+               << ",\"dur\":" << ToMicroseconds(event.end - event.begin) << ",\"args\":{";
+            for (std::size_t i = 0; i < event.args.size(); ++i)
+            {
+                os << (i == 0 ? "" : ",");
+                WriteJsonString(os, event.args[i].first);
+                os << ':';
+                WriteJsonString(os, event.args[i].second);
+            }
+            os << "}}";
+        }
+        os << "\n]}\n";
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,133 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_STARTUPPROFILER_H
+#define CPPMICROSERVICES_STARTUPPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    /**
+     * Records the phases of framework and bundle start-up with their
+     * monotonic begin and end times and the threads they ran on, and writes
+     * them as a Chrome trace-event JSON file, see
+     * Constants::FRAMEWORK_STARTUP_TRACE.
+     *
+     * Spans are cheap while the profiler is closed, so they are placed on
+     * the regular code paths unconditionally.
+     */
+    class StartupProfiler
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+        using Args = std::vector<std::pair<char const*, std::string>>;
+
+        /**
+         * Records the time between its construction and destruction, if the
+         * profiler was open when it was constructed.
+         */
+        class Span
+        {
+          public:
+            Span(StartupProfiler& profiler, char const* name, char const* category);
+            ~Span();
+
+            Span(Span const&) = delete;
+            Span& operator=(Span const&) = delete;
+
+            bool
+            IsRecording() const
+            {
+                return profiler != nullptr;
+            }
+
+            /**
+             * Attach an argument shown with the span. Does nothing if the span
+             * is not recording.
+             */
+            void AddArg(char const* key, std::string const& value);
+
+          private:
+            StartupProfiler* profiler;
+            char const* name;
+            char const* category;
+            Clock::time_point begin;
+            Args args;
+        };
+
+        StartupProfiler();
+
+        /**
+         * Start recording, to be written to \c tracePath when the profiler is
+         * closed. Does nothing if \c tracePath is empty.
+         */
+        void Open(std::string const& tracePath);
+
+        /**
+         * Stop recording and write the recorded spans to the trace file.
+         *
+         * @throws std::runtime_error If the trace file cannot be written.
+         */
+        void Close();
+
+        bool
+        IsOpen() const
+        {
+            return open.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Write the spans recorded so far in the Chrome trace-event JSON format.
+         */
+        void WriteTrace(std::ostream& os) const;
+
+      private:
+        struct Event
+        {
+            char const* name;
+            char const* category;
+            Clock::time_point begin;
+            Clock::time_point end;
+            std::thread::id thread;
+            Args args;
+        };
+
+        void Record(Event&& event);
+
+        std::atomic<bool> open;
+        mutable std::mutex mutex;
+        std::string tracePath;
+        Clock::time_point origin;
+        std::vector<Event> events;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_STARTUPPROFILER_H
@@ -101,7 +101,10 @@ namespace cppmicroservices
                                return std::all_of(names.begin(),
                                                   names.end(),
                                                   [](const std::string& resourceName) -> bool
-                                                  { return resourceName == std::string("manifest.json"); });
+                                                  {
+                                                      return resourceName == std::string("manifest.json")
+                                                             || resourceName == std::string("manifest.bin");
+                                                  });
                            });
     }
 
@@ -155,7 +155,8 @@ namespace cppmicroservices
      * @param resContainer The BundleResourceContainer to check
      *
      * @return true if the bundle's zip file only contains a
-     *         manifest file, false otherwise.
+     *         manifest file (manifest.json and its optional binary form
+     *         manifest.bin), false otherwise.
      * @throw std::runtime_error if the bundle manifest cannot be read.
      */
     bool OnlyContainsManifest(std::shared_ptr<BundleResourceContainer> const& resContainer);
@@ -0,0 +1,81 @@
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/BundleResourceStream.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "../../src/bundle/BundleManifest.h"
+
+#include <chrono>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+class BundleManifestFixture : public ::benchmark::Fixture
+{
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    void
+    SetUp(::benchmark::State const&)
+    {
+        auto framework = FrameworkFactory().NewFramework();
+        framework.Start();
+
+        // DataOnlyTestBundle has a large, deeply nested manifest and is built
+        // with its binary form.
+        auto bundle = testing::InstallLib(framework.GetBundleContext(), "DataOnlyTestBundle");
+        json = Read(bundle.GetResource("manifest.json"));
+        binary = Read(bundle.GetResource("manifest.bin"));
+
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    ~BundleManifestFixture() = default;
+
+  protected:
+    static std::string
+    Read(BundleResource const& resource)
+    {
+        BundleResourceStream rs(resource, std::ios_base::binary);
+        return std::string(std::istreambuf_iterator<char>(rs), std::istreambuf_iterator<char>());
+    }
+
+    std::string json;
+    std::string binary;
+};
+
+BENCHMARK_DEFINE_F(BundleManifestFixture, ParseJsonManifest)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::istringstream is(json);
+        BundleManifest manifest;
+        manifest.Parse(is);
+        benchmark::DoNotOptimize(manifest.GetHeaders());
+    }
+}
+
+BENCHMARK_DEFINE_F(BundleManifestFixture, ParseBinaryManifest)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BundleManifest manifest;
+        manifest.ParseBinary(binary);
+        benchmark::DoNotOptimize(manifest.GetHeaders());
+    }
+}
+
+BENCHMARK_REGISTER_F(BundleManifestFixture, ParseJsonManifest);
+BENCHMARK_REGISTER_F(BundleManifestFixture, ParseBinaryManifest);
+#endif
@@ -0,0 +1,70 @@
+#include "cppmicroservices/util/BundleObjFactory.h"
+#include "cppmicroservices/util/BundleElfFile.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <string>
+#include <vector>
+
+#include "TestUtils.h"
+#include "TestingConfig.h"
+#include "benchmark/benchmark.h"
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+namespace
+{
+    // Cycle through the test bundle libraries until 1000 locations are
+    // collected, which mimics re-installing a large set of bundles.
+    std::vector<std::string>
+    Make1kBundleLocations()
+    {
+        std::vector<std::string> const names
+            = { "TestBundleA",     "TestBundleA2", "TestBundleBA_00", "TestBundleBA_01", "TestBundleBA_S1",
+                "TestBundleBA_X1", "TestBundleC1", "TestBundleH",     "TestBundleLQ",    "TestBundleM",
+                "TestBundleR",     "TestBundleRL", "TestBundleS",     "TestBundleSL1",   "TestBundleSL3",
+                "TestBundleSL4" };
+
+        std::vector<std::string> locations;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            locations.push_back(testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + names[i % names.size()]
+                                + US_LIB_POSTFIX + US_LIB_EXT);
+        }
+        return locations;
+    }
+} // namespace
+
+static void
+CreateBundleObjFiles(benchmark::State& state)
+{
+    auto const locations = Make1kBundleLocations();
+    for (auto _ : state)
+    {
+        for (auto const& location : locations)
+        {
+            benchmark::DoNotOptimize(BundleObjFactory().CreateBundleFileObj(location));
+        }
+    }
+}
+
+#    if defined(US_PLATFORM_LINUX)
+// Parse the ELF headers of every library, bypassing the BundleObjFactory cache.
+static void
+CreateUncachedBundleElfFiles(benchmark::State& state)
+{
+    auto const locations = Make1kBundleLocations();
+    for (auto _ : state)
+    {
+        for (auto const& location : locations)
+        {
+            benchmark::DoNotOptimize(CreateBundleElfFile(location));
+        }
+    }
+}
+
+BENCHMARK(CreateUncachedBundleElfFiles);
+#    endif
+
+BENCHMARK(CreateBundleObjFiles);
+#endif
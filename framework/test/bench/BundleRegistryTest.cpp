@@ -0,0 +1,82 @@
+#include <cppmicroservices/AnyMap.h>
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TestUtils.h"
+#include "TestingConfig.h"
+#include "benchmark/benchmark.h"
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+class BundleRegistryFixture : public ::benchmark::Fixture
+{
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    // Install state.range(0) bundles from a single test library by injecting
+    // one manifest per bundle, which avoids building that many libraries.
+    void
+    SetUp(::benchmark::State const& state)
+    {
+        framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+        framework->Start();
+
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        for (auto i = 0; i < state.range(0); ++i)
+        {
+            auto const name = "registry_bundle_" + std::to_string(i);
+            manifests[name] = AnyMap(AnyMap::unordered_any_cimap { { Constants::BUNDLE_SYMBOLICNAME, name } });
+        }
+
+        auto const location = testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + "TestBundleA" + US_LIB_POSTFIX
+                              + US_LIB_EXT;
+        for (auto const& bundle : framework->GetBundleContext().InstallBundles(location, manifests))
+        {
+            ids.push_back(bundle.GetBundleId());
+        }
+    }
+
+    void
+    TearDown(::benchmark::State const&)
+    {
+        ids.clear();
+        framework->Stop();
+        framework->WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    ~BundleRegistryFixture() { framework.reset(); }
+
+  protected:
+    std::shared_ptr<Framework> framework;
+    std::vector<long> ids;
+};
+
+// Look up every installed bundle by its id.
+BENCHMARK_DEFINE_F(BundleRegistryFixture, GetBundleById)(benchmark::State& state)
+{
+    auto context = framework->GetBundleContext();
+    for (auto _ : state)
+    {
+        for (auto id : ids)
+        {
+            benchmark::DoNotOptimize(context.GetBundle(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+
+BENCHMARK_REGISTER_F(BundleRegistryFixture, GetBundleById)->Arg(10)->Arg(100)->Arg(1000);
+#endif
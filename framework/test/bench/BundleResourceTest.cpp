@@ -0,0 +1,107 @@
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/BundleResourceStream.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+
+using namespace cppmicroservices;
+
+class BundleResourceFixture : public ::benchmark::Fixture
+{
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    void
+    SetUp(::benchmark::State const&)
+    {
+        framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+        framework->Start();
+
+        // The resources of this bundle are linked into the library and read
+        // from the memory mapped file.
+        auto bundle = testing::InstallLib(framework->GetBundleContext(), "TestBundleRL");
+        for (auto const& resource : bundle.FindResources("", "*", true))
+        {
+            if (resource.IsFile())
+            {
+                resources.push_back(resource);
+            }
+        }
+    }
+
+    void
+    TearDown(::benchmark::State const&)
+    {
+        resources.clear();
+        framework->Stop();
+        framework->WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    ~BundleResourceFixture() { framework.reset(); }
+
+  protected:
+    std::size_t
+    ReadResources(int repetitions) const
+    {
+        std::size_t bytes = 0;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            for (auto const& resource : resources)
+            {
+                BundleResourceStream rs(resource, std::ios_base::binary);
+                bytes += std::string(std::istreambuf_iterator<char>(rs), std::istreambuf_iterator<char>()).size();
+            }
+        }
+        return bytes;
+    }
+
+    std::shared_ptr<Framework> framework;
+    std::vector<BundleResource> resources;
+};
+
+// Read all resources of one bundle from state.range(0) threads at once.
+BENCHMARK_DEFINE_F(BundleResourceFixture, ConcurrentResourceReads)(benchmark::State& state)
+{
+    auto const threadCount = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<std::future<std::size_t>> readers;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            readers.push_back(std::async(std::launch::async, [this] { return ReadResources(100); }));
+        }
+
+        std::size_t bytes = 0;
+        for (auto& reader : readers)
+        {
+            bytes += reader.get();
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+}
+
+// Look up resources by path and pattern; both use the container's entry index.
+BENCHMARK_DEFINE_F(BundleResourceFixture, FindResources)(benchmark::State& state)
+{
+    auto bundle = testing::InstallLib(framework->GetBundleContext(), "TestBundleR");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bundle.FindResources("", "*.txt", true));
+        benchmark::DoNotOptimize(bundle.GetResource("/icons/compressable.bmp"));
+    }
+}
+
+BENCHMARK_REGISTER_F(BundleResourceFixture, ConcurrentResourceReads)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK_REGISTER_F(BundleResourceFixture, FindResources);
@@ -0,0 +1,84 @@
+#include <cppmicroservices/AnyMap.h>
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/ServiceEvent.h>
+
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "TestUtils.h"
+#include "TestingConfig.h"
+#include "benchmark/benchmark.h"
+#include "fooservice.h"
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+namespace
+{
+    // Start state.range(0) bundles, each registering a few services and, if
+    // state.range(2) is set, listening for the services of all others.
+    Framework
+    StartBundles(::benchmark::State const& state)
+    {
+        FrameworkConfiguration frameworkConfig;
+        frameworkConfig[Constants::FRAMEWORK_FAST_SHUTDOWN] = state.range(1) != 0;
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        framework.Start();
+
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        for (auto i = 0; i < state.range(0); ++i)
+        {
+            auto const name = "shutdown_bundle_" + std::to_string(i);
+            manifests[name] = AnyMap(AnyMap::unordered_any_cimap { { Constants::BUNDLE_SYMBOLICNAME, name } });
+        }
+
+        auto const location = testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + "TestBundleA" + US_LIB_POSTFIX
+                              + US_LIB_EXT;
+        for (auto& bundle : framework.GetBundleContext().InstallBundles(location, manifests))
+        {
+            bundle.Start();
+            auto context = bundle.GetBundleContext();
+            for (auto s = 0; s < 5; ++s)
+            {
+                context.RegisterService<benchmark::test::Foo>(std::make_shared<benchmark::test::FooImpl>());
+            }
+            if (state.range(2) != 0)
+            {
+                context.AddServiceListener([](ServiceEvent const&) {}, "(objectclass=benchmark::test::Foo)");
+            }
+        }
+        return framework;
+    }
+} // namespace
+
+// Stop a framework with many active bundles, one after the other or in the
+// fast shutdown mode.
+static void
+FrameworkShutdown(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto framework = StartBundles(state);
+        state.ResumeTiming();
+
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+}
+
+BENCHMARK(FrameworkShutdown)
+    ->Args({ 800, 0, 0 })
+    ->Args({ 800, 1, 0 })
+    ->Args({ 800, 0, 1 })
+    ->Args({ 800, 1, 1 })
+    ->Unit(benchmark::kMillisecond);
+#endif
@@ -11,9 +11,13 @@
 #include <cppmicroservices/ServiceObjects.h>
 
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <thread>
 #include <vector>
 
+#include "TestUtils.h"
+
 using namespace cppmicroservices;
 
 namespace
@@ -25,6 +29,32 @@ namespace
     {
     };
 
+    /*
+     * Bundle scope factory which takes a while to create each service instance
+     */
+    class SlowServiceFactory : public ServiceFactory
+    {
+      public:
+        InterfaceMapConstPtr
+        GetService(Bundle const&, ServiceRegistrationBase const&) override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return MakeInterfaceMap<TestInterface>(std::make_shared<TestInterface>());
+        }
+
+        void
+        UngetService(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&) override
+        {
+        }
+    };
+
+    /*
+     * Test bundles without side effects which are used as service consumers
+     */
+    std::vector<std::string> const consumerBundleNames = { "TestBundleA",     "TestBundleA2", "TestBundleBA_00",
+                                                           "TestBundleBA_01", "TestBundleM",  "TestBundleBA_S1",
+                                                           "TestBundleBA_X1", "TestBundleLQ" };
+
     class ServiceRegistryFixture : public ::benchmark::Fixture
     {
       public:
@@ -142,6 +172,35 @@ BENCHMARK_REGISTER_F(ServiceRegistryFixture, RegisterServicesWithRank)
 })
     ->UseManualTime();
 
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, RegisterServiceWithProperties)
+(benchmark::State& state)
+{
+    auto fc = framework->GetBundleContext();
+    ServiceProperties props;
+    for (auto i = state.range(0); i > 0; --i)
+    {
+        props["service.property.key" + std::to_string(i)] = Any(static_cast<int>(i));
+    }
+
+    for (auto _ : state)
+    {
+        auto reg = fc.RegisterService<TestInterface>(std::make_shared<TestInterface>(), props);
+        state.PauseTiming();
+        reg.Unregister();
+        state.ResumeTiming();
+    }
+}
+
+// The parameter specifies the number of service properties, which are checked
+// for keys that differ in case only on registration.
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, RegisterServiceWithProperties)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256);
+
 BENCHMARK_DEFINE_F(ServiceRegistryFixture, FindServices)
 (benchmark::State& state)
 {
@@ -259,3 +318,153 @@ BENCHMARK_REGISTER_F(ServiceRegistryFixture, ModifyServices)
         {1, 1000}
 })
     ->UseManualTime();
+
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, GetSingletonServiceConcurrently)
+(benchmark::State& state)
+{
+    using namespace std::chrono;
+
+    auto fc = framework->GetBundleContext();
+    auto threadCount = state.range(0);
+    constexpr int callsPerThread = 10000;
+
+    fc.RegisterService<TestInterface>(std::make_shared<TestInterface>());
+    auto ref = fc.GetServiceReference<TestInterface>();
+    // keep the service in use for the whole benchmark, as a long-lived consumer would
+    auto held = fc.GetService(ref);
+
+    for (auto _ : state)
+    {
+        std::vector<std::future<void>> results;
+        auto start = high_resolution_clock::now();
+
+        for (auto t = threadCount; t > 0; --t)
+        {
+            results.push_back(std::async(std::launch::async,
+                                         [&fc, &ref]()
+                                         {
+                                             for (int i = 0; i < callsPerThread; ++i)
+                                             {
+                                                 auto svc = fc.GetService(ref);
+                                                 benchmark::DoNotOptimize(svc);
+                                             }
+                                         }));
+        }
+
+        for (auto& result : results)
+        {
+            result.get();
+        }
+
+        auto end = high_resolution_clock::now();
+        auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+}
+
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, GetSingletonServiceConcurrently)
+    ->RangeMultiplier(8)
+    ->Range(1, 64)
+    ->UseManualTime();
+
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, GetFactoryServiceFromConcurrentBundles)
+(benchmark::State& state)
+{
+    using namespace std::chrono;
+
+    auto fc = framework->GetBundleContext();
+    std::vector<BundleContext> consumers;
+    for (auto i = 0; i < state.range(0); ++i)
+    {
+        auto bundle = testing::InstallLib(fc, consumerBundleNames[i]);
+        bundle.Start();
+        consumers.push_back(bundle.GetBundleContext());
+    }
+
+    fc.RegisterService<TestInterface>(ToFactory(std::make_shared<SlowServiceFactory>()));
+    auto ref = fc.GetServiceReference<TestInterface>();
+
+    for (auto _ : state)
+    {
+        std::vector<std::future<std::shared_ptr<TestInterface>>> results;
+        auto start = high_resolution_clock::now();
+
+        // every consumer bundle requests its own instance, a few times at once
+        for (auto& consumer : consumers)
+        {
+            for (int t = 0; t < 4; ++t)
+            {
+                results.push_back(std::async(std::launch::async,
+                                             [&consumer, &ref]() { return consumer.GetService(ref); }));
+            }
+        }
+
+        std::vector<std::shared_ptr<TestInterface>> services;
+        for (auto& result : results)
+        {
+            services.push_back(result.get());
+        }
+
+        auto end = high_resolution_clock::now();
+        auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+}
+
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, GetFactoryServiceFromConcurrentBundles)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseManualTime();
+
+static void
+StopFrameworkWithUsedServices(benchmark::State& state)
+{
+    using namespace std::chrono;
+
+    auto const serviceCount = state.range(0);
+    auto const bundleCount = state.range(1);
+
+    for (auto _ : state)
+    {
+        auto framework = FrameworkFactory().NewFramework();
+        framework.Start();
+        auto fc = framework.GetBundleContext();
+        for (auto i = 0; i < serviceCount; ++i)
+        {
+            fc.RegisterService<TestInterface>(std::make_shared<TestInterface>());
+        }
+        auto refs = fc.GetServiceReferences<TestInterface>();
+
+        // every bundle, including the framework itself, keeps using a few of the services
+        std::vector<std::shared_ptr<TestInterface>> used;
+        std::vector<BundleContext> consumers { fc };
+        for (auto i = 0; i < bundleCount; ++i)
+        {
+            auto bundle = testing::InstallLib(fc, consumerBundleNames[i]);
+            bundle.Start();
+            consumers.push_back(bundle.GetBundleContext());
+        }
+        for (auto& consumer : consumers)
+        {
+            for (std::size_t i = 0; i < refs.size() && i < 10; ++i)
+            {
+                used.push_back(consumer.GetService(refs[i]));
+            }
+        }
+        consumers.clear();
+
+        auto start = high_resolution_clock::now();
+        framework.Stop();
+        framework.WaitForStop(milliseconds::zero());
+        auto end = high_resolution_clock::now();
+        auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+}
+
+BENCHMARK(StopFrameworkWithUsedServices)
+    ->Ranges({
+        {1000, 10000},
+        {   1,     8}
+})
+    ->UseManualTime();
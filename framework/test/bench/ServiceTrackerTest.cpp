@@ -1,12 +1,14 @@
 #include <cppmicroservices/Bundle.h>
 #include <cppmicroservices/BundleContext.h>
 #include <cppmicroservices/BundleEvent.h>
+#include <cppmicroservices/Constants.h>
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
 #include <cppmicroservices/ServiceTracker.h>
 
 #include <chrono>
+#include <future>
 #include <unordered_set>
 
 #include "benchmark/benchmark.h"
@@ -201,6 +203,56 @@ BENCHMARK_DEFINE_F(ServiceTrackerFixture, ServiceTrackerScalabilityWithLDAPFilte
     }
 }
 
+/// Benchmark concurrent reads of the highest ranked service from one service tracker
+/// while it tracks state.range(0) services of different rankings.
+BENCHMARK_DEFINE_F(ServiceTrackerFixture, ConcurrentGetService)
+(benchmark::State& state)
+{
+    using namespace std::chrono;
+    using namespace benchmark::test;
+    using namespace cppmicroservices;
+
+    constexpr int threadCount = 32;
+    constexpr int callsPerThread = 10000;
+
+    auto fc = framework->GetBundleContext();
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        fc.RegisterService<Foo>(std::make_shared<FooImpl>(),
+                                { { Constants::SERVICE_RANKING, Any(static_cast<int>(i % 10)) } });
+    }
+
+    ServiceTracker<Foo> fooTracker(fc);
+    fooTracker.Open();
+
+    for (auto _ : state)
+    {
+        std::vector<std::future<void>> readers;
+        auto start = high_resolution_clock::now();
+        for (int t = 0; t < threadCount; ++t)
+        {
+            readers.push_back(std::async(std::launch::async,
+                                         [&fooTracker]()
+                                         {
+                                             for (int i = 0; i < callsPerThread; ++i)
+                                             {
+                                                 auto foo = fooTracker.GetService();
+                                                 benchmark::DoNotOptimize(foo);
+                                             }
+                                         }));
+        }
+        for (auto& reader : readers)
+        {
+            reader.get();
+        }
+        auto end = high_resolution_clock::now();
+        auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+
+    fooTracker.Close();
+}
+
 static void
 CloseServiceTracker(benchmark::State& state)
 {
@@ -238,6 +290,7 @@ BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithSvcRef)->UseMa
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithBundleContext)->UseManualTime();
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, OpenServiceTrackerWithInterfaceName)->UseManualTime();
 BENCHMARK(CloseServiceTracker)->RangeMultiplier(2)->Range(1000, 1000000);
+BENCHMARK_REGISTER_F(ServiceTrackerFixture, ConcurrentGetService)->Arg(1)->Arg(1000)->UseManualTime();
 
 // Run this benchmark for each Arg(...) call, passing in the parameter value to the benchmark.
 BENCHMARK_REGISTER_F(ServiceTrackerFixture, ServiceTrackerScalability)->Arg(1)->Arg(4000)->Arg(10000);
@@ -2,6 +2,7 @@
 #include <cppmicroservices/Bundle.h>
 #include <cppmicroservices/BundleContext.h>
 #include <cppmicroservices/BundleEvent.h>
+#include <cppmicroservices/Constants.h>
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
@@ -10,6 +11,14 @@
 #include "TestUtils.h"
 #include "benchmark/benchmark.h"
 
+namespace
+{
+    std::vector<std::string> const cachedBundleNames
+        = { "TestBundleA",     "TestBundleA2", "TestBundleBA_00", "TestBundleBA_01", "TestBundleBA_S1",
+            "TestBundleBA_X1", "TestBundleC1", "TestBundleH",     "TestBundleLQ",    "TestBundleM",
+            "TestBundleS",     "TestBundleSL1", "TestBundleSL3",  "TestBundleSL4" };
+} // namespace
+
 class BundleInstallFixture : public ::benchmark::Fixture
 {
   public:
@@ -39,6 +48,21 @@ class BundleInstallFixture : public ::benchmark::Fixture
         return bundles;
     }
 
+    static std::vector<std::string>
+    Make5kBundlePaths()
+    {
+        std::string bundleBasePath = "bundles\\bundle_";
+
+        // Generate paths to each bundle
+        uint32_t count = 1;
+        std::vector<std::string> str5kBundles(5000, bundleBasePath);
+        std::transform(str5kBundles.begin(),
+                       str5kBundles.end(),
+                       str5kBundles.begin(),
+                       [&count](std::string& s) -> std::string { return s.append(std::to_string(count++)); });
+        return str5kBundles;
+    }
+
   protected:
     void
     InstallWithCppFramework(benchmark::State& state, std::string const& bundleName)
@@ -65,22 +89,160 @@ class BundleInstallFixture : public ::benchmark::Fixture
         framework.WaitForStop(std::chrono::milliseconds::zero());
     }
 
+    // Installs the test bundles into a new framework, either one location after the
+    // other or all of them with one call of the batched InstallBundles overload.
+    void
+    InstallTestBundles(benchmark::State& state, bool batched)
+    {
+        using namespace std::chrono;
+        using namespace cppmicroservices;
+
+        std::vector<std::string> locations;
+        {
+            auto framework = FrameworkFactory().NewFramework();
+            framework.Start();
+            for (auto const& bundle : ConcurrentInstallHelper(framework, cachedBundleNames))
+            {
+                locations.push_back(bundle.GetLocation());
+            }
+            framework.Stop();
+            framework.WaitForStop(milliseconds::zero());
+        }
+
+        for (auto _ : state)
+        {
+            auto framework = FrameworkFactory().NewFramework();
+            framework.Start();
+            auto context = framework.GetBundleContext();
+
+            auto start = high_resolution_clock::now();
+            if (batched)
+            {
+                context.InstallBundles(locations);
+            }
+            else
+            {
+                for (auto const& location : locations)
+                {
+                    context.InstallBundles(location);
+                }
+            }
+            auto end = high_resolution_clock::now();
+            auto elapsed = duration_cast<duration<double>>(end - start);
+            state.SetIterationTime(elapsed.count());
+
+            framework.Stop();
+            framework.WaitForStop(milliseconds::zero());
+        }
+    }
+
+    void
+    InstallBatched(benchmark::State& state)
+    {
+        using namespace std::chrono;
+
+        auto framework = cppmicroservices::FrameworkFactory().NewFramework();
+        framework.Start();
+
+        auto str5kBundles = Make5kBundlePaths();
+        for (auto _ : state)
+        {
+            auto start = high_resolution_clock::now();
+            framework.GetBundleContext().InstallBundles(str5kBundles);
+            auto end = high_resolution_clock::now();
+            auto elapsed_seconds = duration_cast<duration<double>>(end - start);
+            state.SetIterationTime(elapsed_seconds.count());
+        }
+
+        framework.Stop();
+        framework.WaitForStop(milliseconds::zero());
+    }
+
+    // Measures starting a framework with the persistent bundle cache enabled and
+    // installing a set of bundles, either with an empty cache (cold) or with a
+    // cache written by a previous framework instance (warm).
+    void
+    StartWithBundleCache(benchmark::State& state, bool warm)
+    {
+        using namespace std::chrono;
+        using namespace cppmicroservices;
+
+        testing::TempDir storage = testing::MakeUniqueTempDirectory();
+        FrameworkConfiguration config;
+        config[Constants::FRAMEWORK_STORAGE] = static_cast<std::string>(storage);
+        config[Constants::FRAMEWORK_BUNDLE_CACHE] = true;
+        if (warm)
+        {
+            auto framework = FrameworkFactory().NewFramework(config);
+            framework.Start();
+            ConcurrentInstallHelper(framework, cachedBundleNames);
+            framework.Stop();
+            framework.WaitForStop(milliseconds::zero());
+        }
+        else
+        {
+            config[Constants::FRAMEWORK_STORAGE_CLEAN] = Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT;
+        }
+
+        for (auto _ : state)
+        {
+            auto start = high_resolution_clock::now();
+            auto framework = FrameworkFactory().NewFramework(config);
+            framework.Start();
+            ConcurrentInstallHelper(framework, cachedBundleNames);
+            auto end = high_resolution_clock::now();
+            auto elapsed = duration_cast<duration<double>>(end - start);
+            state.SetIterationTime(elapsed.count());
+
+            framework.Stop();
+            framework.WaitForStop(milliseconds::zero());
+        }
+    }
+
+    // Starts the test bundles of a new framework, either one bundle after the
+    // other or all of them with one call of Framework::StartBundles.
+    void
+    StartTestBundles(benchmark::State& state, bool scheduled)
+    {
+        using namespace std::chrono;
+        using namespace cppmicroservices;
+
+        for (auto _ : state)
+        {
+            auto framework = FrameworkFactory().NewFramework();
+            framework.Start();
+            auto bundles = ConcurrentInstallHelper(framework, cachedBundleNames);
+
+            auto start = high_resolution_clock::now();
+            if (scheduled)
+            {
+                framework.StartBundles(bundles);
+            }
+            else
+            {
+                for (auto& bundle : bundles)
+                {
+                    bundle.Start();
+                }
+            }
+            auto end = high_resolution_clock::now();
+            auto elapsed = duration_cast<duration<double>>(end - start);
+            state.SetIterationTime(elapsed.count());
+
+            framework.Stop();
+            framework.WaitForStop(milliseconds::zero());
+        }
+    }
+
     void
     InstallConcurrently(benchmark::State& state, uint32_t numThreads)
     {
         using namespace std::chrono;
 
-        std::string bundleBasePath = "bundles\\bundle_";
         auto framework = cppmicroservices::FrameworkFactory().NewFramework();
         framework.Start();
 
-        // Generate paths to each bundle
-        uint32_t count = 1;
-        std::vector<std::string> str5kBundles(5000, bundleBasePath);
-        std::transform(str5kBundles.begin(),
-                       str5kBundles.end(),
-                       str5kBundles.begin(),
-                       [&count](std::string& s) -> std::string { return s.append(std::to_string(count++)); });
+        auto str5kBundles = Make5kBundlePaths();
 
         // Split up bundles per thread
         uint32_t numBundlesToInstall = uint32_t(str5kBundles.size()) / numThreads;
@@ -138,6 +300,24 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, BundleInstallCppFramework)
 BENCHMARK_DEFINE_F(BundleInstallFixture, LargeBundleInstallCppFramework)
 (benchmark::State& state) { InstallWithCppFramework(state, "largeBundle"); }
 
+BENCHMARK_DEFINE_F(BundleInstallFixture, SequentialTestBundlesInstall)
+(benchmark::State& state) { InstallTestBundles(state, false); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, BatchedTestBundlesInstall)
+(benchmark::State& state) { InstallTestBundles(state, true); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, SequentialTestBundlesStart)
+(benchmark::State& state) { StartTestBundles(state, false); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, ScheduledTestBundlesStart)
+(benchmark::State& state) { StartTestBundles(state, true); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, ColdStartWithBundleCache)
+(benchmark::State& state) { StartWithBundleCache(state, false); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, WarmStartWithBundleCache)
+(benchmark::State& state) { StartWithBundleCache(state, true); }
+
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)
 (benchmark::State& state) { InstallConcurrently(state, 1); }
@@ -152,15 +332,24 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstallMaxThreads)
 (benchmark::State& state) { InstallConcurrently(state, std::thread::hardware_concurrency()); }
 BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1ThreadPerBundle)
 (benchmark::State& state) { InstallConcurrently(state, 5000); }
+BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstallBatched)
+(benchmark::State& state) { InstallBatched(state); }
 #endif
 
 // Register functions as benchmark
 BENCHMARK_REGISTER_F(BundleInstallFixture, BundleInstallCppFramework)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, LargeBundleInstallCppFramework)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, SequentialTestBundlesInstall)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, BatchedTestBundlesInstall)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, SequentialTestBundlesStart)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, ScheduledTestBundlesStart)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, ColdStartWithBundleCache)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, WarmStartWithBundleCache)->UseManualTime();
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall2Threads)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall4Threads)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstallMaxThreads)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall1ThreadPerBundle)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstallBatched)->UseManualTime();
 #endif
@@ -37,7 +37,9 @@
 #include "../../src/bundle/BundleManifest.h"
 #include "cppmicroservices/BundleResourceStream.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 US_MSVC_PUSH_DISABLE_WARNING(4996)
 
@@ -116,6 +118,42 @@ namespace
         return true;
     }
 
+    /**
+     * Recursively compare the types and values of two manifest values.
+     */
+    bool
+    same_manifest_value(Any const& lhs, Any const& rhs)
+    {
+        if (lhs.Type() != rhs.Type())
+        {
+            return false;
+        }
+        if (lhs.Type() == typeid(AnyMap))
+        {
+            auto const& lhsMap = ref_any_cast<AnyMap>(lhs);
+            auto const& rhsMap = ref_any_cast<AnyMap>(rhs);
+            return lhsMap.GetType() == rhsMap.GetType() && lhsMap.size() == rhsMap.size()
+                   && std::all_of(lhsMap.begin(),
+                                  lhsMap.end(),
+                                  [&rhsMap](auto const& entry)
+                                  {
+                                      auto iter = rhsMap.find(entry.first);
+                                      return iter != rhsMap.end() && same_manifest_value(entry.second, iter->second);
+                                  });
+        }
+        if (lhs.Type() == typeid(std::vector<Any>))
+        {
+            auto const& lhsVector = ref_any_cast<std::vector<Any>>(lhs);
+            auto const& rhsVector = ref_any_cast<std::vector<Any>>(rhs);
+            return std::equal(lhsVector.begin(),
+                              lhsVector.end(),
+                              rhsVector.begin(),
+                              rhsVector.end(),
+                              same_manifest_value);
+        }
+        return lhs == rhs;
+    }
+
 } // namespace
 
 namespace cppmicroservices
@@ -716,6 +754,114 @@ namespace cppmicroservices
         EXPECT_THROW(manifest.Parse(jsonStream), std::runtime_error);
     }
 
+    TEST_F(BundleManifestTest, ParseNestedJsonAndLocalizationPrefix)
+    {
+        std::istringstream jsonStream(R"({
+            "bundle.symbolic_name": "%nested",
+            "Outer": { "Inner": [1, "%two", { "Three": 3.5 }] }
+        })");
+
+        BundleManifest manifest;
+        manifest.Parse(jsonStream);
+
+        EXPECT_EQ(any_cast<std::string>(manifest.GetValue("BUNDLE.SYMBOLIC_NAME")), "nested");
+        auto const& outer = ref_any_cast<AnyMap>(manifest.GetHeaders().at("outer"));
+        EXPECT_EQ(outer.GetType(), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        auto const& inner = ref_any_cast<std::vector<Any>>(outer.at("inner"));
+        ASSERT_EQ(inner.size(), 3u);
+        EXPECT_EQ(any_cast<int>(inner[0]), 1);
+        EXPECT_EQ(any_cast<std::string>(inner[1]), "two");
+        EXPECT_EQ(any_cast<double>(ref_any_cast<AnyMap>(inner[2]).at("three")), 3.5);
+    }
+
+    TEST_F(BundleManifestTest, ParseManifestLargerThanParseArena)
+    {
+        // Make the document large enough that the JSON DOM cannot be held in the
+        // initial arena and has to grow into heap allocated chunks.
+        std::string json = "{";
+        for (int i = 0; i < 2000; ++i)
+        {
+            json += "\"key" + std::to_string(i) + "\": \"value" + std::to_string(i) + "\",";
+        }
+        json += "\"last\": true}";
+        std::istringstream jsonStream(json);
+
+        BundleManifest manifest;
+        manifest.Parse(jsonStream);
+
+        EXPECT_EQ(manifest.GetHeaders().size(), 2001u);
+        EXPECT_EQ(any_cast<std::string>(manifest.GetValue("KEY1999")), "value1999");
+        EXPECT_TRUE(any_cast<bool>(manifest.GetValue("last")));
+    }
+
+    TEST_F(BundleManifestTest, ParseBinary)
+    {
+        // The binary form of
+        // { "bundle.symbolic_name": "%nested", "Outer": { "Inner": [1, "%two", { "Three": 3.5 }] } }
+        std::string const binary = std::string("USBM\x01", 5) + std::string("\x07\x02", 2)
+                                   + "\x14" "bundle.symbolic_name" "\x05\x07" "%nested"
+                                   + "\x05" "Outer" + std::string("\x07\x01", 2) + "\x05" "Inner"
+                                   + std::string("\x06\x03\x03\x01\x00\x00\x00", 7) + "\x05\x04" "%two"
+                                   + "\x07\x01\x05" "Three"
+                                   + std::string("\x04\x00\x00\x00\x00\x00\x00\x0c\x40", 9);
+        ASSERT_TRUE(BundleManifest::IsBinary(binary));
+
+        BundleManifest manifest;
+        manifest.ParseBinary(binary);
+
+        EXPECT_EQ(any_cast<std::string>(manifest.GetValue("BUNDLE.SYMBOLIC_NAME")), "nested");
+        auto const& outer = ref_any_cast<AnyMap>(manifest.GetHeaders().at("outer"));
+        EXPECT_EQ(outer.GetType(), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        auto const& inner = ref_any_cast<std::vector<Any>>(outer.at("inner"));
+        ASSERT_EQ(inner.size(), 3u);
+        EXPECT_EQ(any_cast<int>(inner[0]), 1);
+        EXPECT_EQ(any_cast<std::string>(inner[1]), "two");
+        EXPECT_EQ(any_cast<double>(ref_any_cast<AnyMap>(inner[2]).at("three")), 3.5);
+    }
+
+    TEST_F(BundleManifestTest, ParseInvalidBinaryThrows)
+    {
+        EXPECT_FALSE(BundleManifest::IsBinary(R"({ "key": true })"));
+        EXPECT_FALSE(BundleManifest::IsBinary(std::string("USBM\x02\x07\x00", 7)));
+
+        BundleManifest manifest;
+        EXPECT_THROW(manifest.ParseBinary(R"({ "key": true })"), std::runtime_error);
+        // Not an object at the root
+        EXPECT_THROW(manifest.ParseBinary(std::string("USBM\x01\x02", 6)), std::runtime_error);
+        // Truncated member list
+        EXPECT_THROW(manifest.ParseBinary(std::string("USBM\x01\x07\x02\x03key\x02", 12)), std::runtime_error);
+        // Trailing data after the root object
+        EXPECT_THROW(manifest.ParseBinary(std::string("USBM\x01\x07\x00\x00", 8)), std::runtime_error);
+    }
+
+#ifdef US_BUILD_SHARED_LIBS
+    // TestBundleM is built with a binary manifest, which must yield the same
+    // headers as its manifest.json.
+    TEST_F(BundleManifestTest, BinaryManifestMatchesJson)
+    {
+        auto f = FrameworkFactory().NewFramework();
+        f.Start();
+        auto bundle = cppmicroservices::testing::InstallLib(f.GetBundleContext(), "TestBundleM");
+
+        auto binaryRes = bundle.GetResource("manifest.bin");
+        ASSERT_TRUE(binaryRes.IsValid());
+        BundleResourceStream binaryStream(binaryRes, std::ios_base::binary);
+        std::string const binary { std::istreambuf_iterator<char>(binaryStream), std::istreambuf_iterator<char>() };
+        BundleManifest binaryManifest;
+        binaryManifest.ParseBinary(binary);
+
+        BundleResourceStream jsonStream(bundle.GetResource("manifest.json"));
+        BundleManifest jsonManifest;
+        jsonManifest.Parse(jsonStream);
+
+        EXPECT_TRUE(same_manifest_value(binaryManifest.GetHeaders(), jsonManifest.GetHeaders()));
+        EXPECT_TRUE(same_manifest_value(bundle.GetHeaders(), jsonManifest.GetHeaders()));
+
+        f.Stop();
+        f.WaitForStop(std::chrono::milliseconds::zero());
+    }
+#endif
+
     TEST_F(BundleManifestTest, GetValueNonExistentKey)
     {
         BundleManifest manifest;
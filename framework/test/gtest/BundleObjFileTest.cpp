@@ -32,6 +32,8 @@
 
 #include "gtest/gtest.h"
 
+#include <fstream>
+
 namespace
 {
 #if defined(US_BUILD_SHARED_LIBS)
@@ -84,6 +86,36 @@ TEST(BundleObjFile, GetRawBundleResourceContainer)
 #endif
 }
 
+#if defined(US_BUILD_SHARED_LIBS) && defined(US_PLATFORM_LINUX)
+// The cached resource section of a bundle library must not be reused after the
+// library at the same location was replaced.
+TEST(BundleObjFile, ReplacedBundleFile)
+{
+    cppmicroservices::testing::File tempFile
+        = cppmicroservices::testing::MakeUniqueTempFile(cppmicroservices::testing::GetTempDirectory());
+    {
+        std::ifstream src(testBundlePath, std::ios_base::binary);
+        std::ofstream dst(tempFile.Path, std::ios_base::binary | std::ios_base::trunc);
+        dst << src.rdbuf();
+    }
+
+    auto bundleObj = cppmicroservices::BundleObjFactory().CreateBundleFileObj(tempFile.Path);
+    ASSERT_TRUE(bundleObj->GetRawBundleResourceContainer());
+    auto const size = bundleObj->GetRawBundleResourceContainer()->GetSize();
+
+    bundleObj = cppmicroservices::BundleObjFactory().CreateBundleFileObj(tempFile.Path);
+    ASSERT_TRUE(bundleObj->GetRawBundleResourceContainer());
+    ASSERT_EQ(size, bundleObj->GetRawBundleResourceContainer()->GetSize());
+
+    {
+        std::ofstream dst(tempFile.Path, std::ios_base::binary | std::ios_base::trunc);
+        dst << "not a shared library";
+    }
+    ASSERT_THROW(cppmicroservices::BundleObjFactory().CreateBundleFileObj(tempFile.Path),
+                 cppmicroservices::InvalidObjFileException);
+}
+#endif
+
 #if defined(US_BUILD_SHARED_LIBS)
 #    if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
 TEST(BundleObjFile, MappedFile)
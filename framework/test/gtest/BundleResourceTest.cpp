@@ -28,7 +28,20 @@ limitations under the License.
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
 
+#include "cppmicroservices/detail/BundleResourceBuffer.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+#include "../../src/bundle/BundleResourceContainer.h"
+#include "miniz.h"
+
 #include "gtest/gtest.h"
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string_view>
 #include <unordered_set>
 
 using namespace cppmicroservices;
@@ -434,6 +447,287 @@ TEST_F(BundleResourceTest, testCompressedResource)
     ASSERT_TRUE(bmp.eof());
 }
 
+TEST_F(BundleResourceTest, testCompressedResourceSeek)
+{
+    // Large compressed resources are decompressed in chunks while reading,
+    // so seek back and forth across chunk boundaries.
+    BundleResource res = testBundle.GetResource("/icons/compressable.bmp");
+    ASSERT_EQ(res.GetSize(), 300122);
+
+    std::ifstream bmp(US_FRAMEWORK_SOURCE_DIR "/test/bundles/libRWithResources/resources/icons/compressable.bmp",
+                      std::ifstream::in | std::ifstream::binary);
+    ASSERT_TRUE(bmp.is_open());
+    std::string const expected((std::istreambuf_iterator<char>(bmp)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(expected.size(), 300122u);
+
+    BundleResourceStream rs(res, std::ios_base::binary);
+    for (std::streamoff offset : { 200000, 10, 131071, 65536, 300121, 0 })
+    {
+        rs.seekg(offset);
+        ASSERT_EQ(rs.tellg(), std::streampos(offset));
+        ASSERT_EQ(rs.get(), static_cast<unsigned char>(expected[static_cast<std::size_t>(offset)]));
+    }
+
+    // Put back a character which belongs to the previous chunk.
+    rs.seekg(65536);
+    rs.peek();
+    ASSERT_TRUE(rs.unget());
+    ASSERT_EQ(rs.tellg(), std::streampos(65535));
+    ASSERT_EQ(rs.get(), static_cast<unsigned char>(expected[65535]));
+
+    rs.seekg(-1, std::ios_base::end);
+    ASSERT_EQ(rs.tellg(), std::streampos(300121));
+    rs.seekg(1, std::ios_base::cur);
+    ASSERT_EQ(rs.get(), std::char_traits<char>::eof());
+    ASSERT_TRUE(rs.eof());
+
+    // Seeking past the end fails.
+    rs.clear();
+    ASSERT_FALSE(rs.seekg(300123));
+}
+
+TEST(BundleResourceStreamTest, testReadErrorSetsBadbit)
+{
+    std::string const data(100, 'x');
+    auto const readData = [&data](bool fail)
+    {
+        return [&data, fail]() -> detail::BundleResourceBuffer::ReadFunction
+        {
+            return [&data, fail, chunks = 0](char const*& chunk) mutable -> std::size_t
+            {
+                if (chunks++ > 0)
+                {
+                    if (fail)
+                    {
+                        throw std::runtime_error("read failed");
+                    }
+                    return 0;
+                }
+                chunk = data.data();
+                return 40;
+            };
+        };
+    };
+
+    // A failing read is not mistaken for the end of the data.
+    detail::BundleResourceBuffer failingBuffer(readData(true), data.size(), std::ios_base::binary);
+    std::istream failing(&failingBuffer);
+    failing.ignore(std::numeric_limits<std::streamsize>::max());
+    ASSERT_EQ(failing.gcount(), 40);
+    ASSERT_TRUE(failing.bad());
+
+    // Neither is data which ends before its expected size.
+    detail::BundleResourceBuffer truncatedBuffer(readData(false), data.size(), std::ios_base::binary);
+    std::istream truncated(&truncatedBuffer);
+    truncated.ignore(std::numeric_limits<std::streamsize>::max());
+    ASSERT_EQ(truncated.gcount(), 40);
+    ASSERT_TRUE(truncated.bad());
+}
+
+#ifndef US_PLATFORM_WINDOWS
+TEST(BundleResourceStreamTest, testSeekDoesNotReread)
+{
+    // In text mode the size depends on a trailing newline, which is only
+    // known once the last chunk has been read.
+    std::string const data = std::string(99, 'x') + "\n";
+    std::size_t opens = 0;
+    detail::BundleResourceBuffer buffer(
+        [&data, &opens]() -> detail::BundleResourceBuffer::ReadFunction
+        {
+            ++opens;
+            return [&data, offset = std::size_t(0)](char const*& chunk) mutable -> std::size_t
+            {
+                std::size_t const chunkSize = std::min<std::size_t>(10, data.size() - offset);
+                chunk = data.data() + offset;
+                offset += chunkSize;
+                return chunkSize;
+            };
+        },
+        data.size(),
+        std::ios_base::in);
+    std::istream rs(&buffer);
+
+    rs.ignore(25);
+    ASSERT_EQ(rs.tellg(), std::streampos(25));
+    ASSERT_TRUE(rs.seekg(55));
+    ASSERT_EQ(rs.get(), 'x');
+    ASSERT_EQ(rs.tellg(), std::streampos(56));
+    ASSERT_EQ(opens, 1u);
+
+    // A failed seek keeps the position.
+    ASSERT_FALSE(rs.seekg(100));
+    rs.clear();
+    ASSERT_EQ(rs.tellg(), std::streampos(56));
+
+    ASSERT_TRUE(rs.seekg(0, std::ios_base::end));
+    ASSERT_EQ(rs.tellg(), std::streampos(99));
+}
+#endif
+
+TEST(BundleResourceStreamTest, testCrcMismatchSetsBadbit)
+{
+    cppmicroservices::testing::TempDir tempDir;
+    std::string const zipPath = tempDir.Path + util::DIR_SEP + "resources.zip";
+
+    // Large enough to be decompressed in chunks.
+    std::string content;
+    for (int i = 0; content.size() < 4 * BundleResourceContainer::ReadChunkSize; ++i)
+    {
+        content += "line " + std::to_string(i) + "\n";
+    }
+
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(mz_zip_archive));
+    ASSERT_TRUE(mz_zip_writer_init_file(&zip, zipPath.c_str(), 0));
+    ASSERT_TRUE(mz_zip_writer_add_mem(&zip, "res/large.txt", content.data(), content.size(), MZ_DEFAULT_COMPRESSION));
+    ASSERT_TRUE(mz_zip_writer_finalize_archive(&zip));
+    ASSERT_TRUE(mz_zip_writer_end(&zip));
+
+    auto const readAll = [&zipPath](std::string& result)
+    {
+        auto container = std::make_shared<BundleResourceContainer>(zipPath, AnyMap(any_map::UNORDERED_MAP));
+        BundleResourceContainer::Stat stat;
+        stat.filePath = "res/large.txt";
+        EXPECT_TRUE(container->GetStat(stat));
+        EXPECT_GT(stat.compressedSize, 0);
+        EXPECT_LT(stat.compressedSize, stat.uncompressedSize);
+
+        auto const index = stat.index;
+        detail::BundleResourceBuffer buffer([container, index] { return container->ReadData(index); },
+                                            stat.uncompressedSize,
+                                            std::ios_base::binary);
+        std::istream is(&buffer);
+        std::ostringstream os;
+        char chunk[4096];
+        while (is.read(chunk, sizeof(chunk)) || is.gcount() > 0)
+        {
+            os.write(chunk, is.gcount());
+        }
+        result = os.str();
+        return !is.bad();
+    };
+
+    std::string result;
+    ASSERT_TRUE(readAll(result));
+    ASSERT_EQ(result, content);
+
+    // Corrupt the CRC in the central directory, which miniz checks against
+    // the decompressed data.
+    std::fstream file(zipPath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto const centralHeader = bytes.rfind(std::string("PK\x01\x02", 4));
+    ASSERT_NE(centralHeader, std::string::npos);
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(centralHeader + 16));
+    file.put(static_cast<char>(bytes[centralHeader + 16] ^ 0xff));
+    file.close();
+
+    ASSERT_FALSE(readAll(result));
+    ASSERT_LT(result.size(), content.size());
+}
+
+TEST(BundleResourceContainerTest, testDirectoryIndex)
+{
+    cppmicroservices::testing::TempDir tempDir;
+    std::string const zipPath = tempDir.Path + util::DIR_SEP + "resources.zip";
+
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(mz_zip_archive));
+    ASSERT_TRUE(mz_zip_writer_init_file(&zip, zipPath.c_str(), 0));
+    for (auto const* name : { "res/",
+                              "res/top.txt",
+                              "res/sub/",
+                              "res/sub/inner.txt",
+                              "res/sub/deeper/",
+                              "res/sub/deeper/leaf.txt",
+                              "res/implicit/file.txt" })
+    {
+        std::string const data = name[std::strlen(name) - 1] == '/' ? "" : name;
+        ASSERT_TRUE(mz_zip_writer_add_mem(&zip, name, data.data(), data.size(), MZ_DEFAULT_COMPRESSION));
+    }
+    ASSERT_TRUE(mz_zip_writer_finalize_archive(&zip));
+    ASSERT_TRUE(mz_zip_writer_end(&zip));
+
+    auto container = std::make_shared<BundleResourceContainer>(zipPath, AnyMap(any_map::UNORDERED_MAP));
+    ASSERT_EQ(container->GetTopLevelDirs(), std::vector<std::string> { "res" });
+
+    auto const children = [&container](std::string const& path, bool relativePaths)
+    {
+        std::vector<std::string> names;
+        std::vector<uint32_t> indices;
+        container->GetChildren(path, relativePaths, names, indices);
+        EXPECT_EQ(names.size(), indices.size());
+        for (std::size_t i = 0; i < names.size() && i < indices.size(); ++i)
+        {
+            BundleResourceContainer::Stat stat;
+            EXPECT_TRUE(container->GetStat(static_cast<int>(indices[i]), stat));
+            EXPECT_EQ(stat.filePath, relativePaths ? path + names[i] : names[i]);
+            EXPECT_EQ(stat.isDir, names[i].back() == '/');
+        }
+        return names;
+    };
+
+    // Children are sorted by name, directories carry a trailing '/'.
+    EXPECT_EQ(children("res/", true), (std::vector<std::string> { "sub/", "top.txt" }));
+    EXPECT_EQ(children("res/", false), (std::vector<std::string> { "res/sub/", "res/top.txt" }));
+
+    // nested directories
+    EXPECT_EQ(children("res/sub/", true), (std::vector<std::string> { "deeper/", "inner.txt" }));
+    EXPECT_EQ(children("res/sub/deeper/", true), std::vector<std::string> { "leaf.txt" });
+
+    // A directory without an explicit zip entry is not listed and has no
+    // children, but its files can still be looked up by path.
+    BundleResourceContainer::Stat stat;
+    stat.filePath = "res/implicit/";
+    EXPECT_FALSE(container->GetStat(stat));
+    EXPECT_TRUE(children("res/implicit/", true).empty());
+    stat.filePath = "res/implicit/file.txt";
+    EXPECT_TRUE(container->GetStat(stat));
+    EXPECT_FALSE(stat.isDir);
+
+    // missing paths
+    stat.filePath = "res/missing.txt";
+    EXPECT_FALSE(container->GetStat(stat));
+    stat.filePath = "res/sub/deeper/missing/leaf.txt";
+    EXPECT_FALSE(container->GetStat(stat));
+    EXPECT_TRUE(children("res/missing/", true).empty());
+    EXPECT_TRUE(children("missing/", true).empty());
+    EXPECT_TRUE(children("res/top.txt", true).empty());
+    EXPECT_TRUE(children("res", true).empty());
+    EXPECT_TRUE(children("", true).empty());
+}
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+TEST_F(BundleResourceTest, testConcurrentResourceReads)
+{
+    auto testBundleRL = cppmicroservices::testing::InstallLib(context, "TestBundleRL");
+    std::vector<BundleResource> resources = testBundleRL.FindResources("", "*", true);
+    resources.push_back(testBundle.GetResource("/icons/compressable.bmp"));
+
+    auto readAll = [&resources]()
+    {
+        std::vector<std::string> contents;
+        for (auto const& res : resources)
+        {
+            BundleResourceStream rs(res, std::ios_base::binary);
+            contents.emplace_back(std::istreambuf_iterator<char>(rs), std::istreambuf_iterator<char>());
+        }
+        return contents;
+    };
+
+    auto const expected = readAll();
+    std::vector<std::future<std::vector<std::string>>> readers;
+    for (int i = 0; i < 8; ++i)
+    {
+        readers.push_back(std::async(std::launch::async, readAll));
+    }
+    for (auto& reader : readers)
+    {
+        ASSERT_EQ(reader.get(), expected);
+    }
+}
+#endif
+
 TEST_F(BundleResourceTest, testResources)
 {
     BundleResource foo = testBundle.GetResource("foo.ptxt");
@@ -447,6 +741,38 @@ TEST_F(BundleResourceTest, testResources)
     ASSERT_EQ(testBundleRA.FindResources("", "*.txt", true).size(), 2);
 }
 
+TEST_F(BundleResourceTest, testStoredResourceData)
+{
+    // Compressed resources and directories have no stored data.
+    ASSERT_TRUE(testBundle.GetResource("/icons/compressable.bmp").GetStoredData().empty());
+    ASSERT_TRUE(testBundle.GetResource("/icons/").GetStoredData().empty());
+    ASSERT_TRUE(BundleResource().GetStoredData().empty());
+
+    // The resources of TestBundleRS are stored uncompressed.
+    auto testBundleRS = cppmicroservices::testing::InstallLib(context, "TestBundleRS");
+    BundleResource res = testBundleRS.GetResource("foo.txt");
+    ASSERT_TRUE(res.IsValid());
+    ASSERT_EQ(res.GetCompressedSize(), res.GetSize());
+
+    std::string const expected = "afoo andasf\nbar\n\n";
+    std::string_view stored = res.GetStoredData();
+#if defined(US_PLATFORM_LINUX)
+    // Linked resources are read from the mapped ELF section.
+    ASSERT_FALSE(stored.empty());
+#endif
+    if (!stored.empty())
+    {
+        // The view points into the mapped bundle and stays valid for copies.
+        ASSERT_EQ(stored, expected);
+        BundleResource copy = res;
+        ASSERT_EQ(copy.GetStoredData().data(), stored.data());
+    }
+
+    BundleResourceStream rs(res, std::ios_base::binary);
+    std::string content((std::istreambuf_iterator<char>(rs)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(content, expected);
+}
+
 TEST_F(BundleResourceTest, testResourceFromExecutable)
 {
     BundleResource resource = executableBundle.GetResource("TestResource.ptxt");
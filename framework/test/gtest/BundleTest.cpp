@@ -45,6 +45,7 @@
 
 #include <chrono>
 #include <future>
+#include <mutex>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -951,6 +952,255 @@ namespace cppmicroservices
     }
 #endif
 
+#if defined(US_BUILD_SHARED_LIBS)
+    // Test installing the bundle libraries at several locations at once.
+    TEST_F(BundleTest, TestInstallBundlesFromLocations)
+    {
+        auto libPath = [](std::string const& name)
+        { return LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + name + US_LIB_POSTFIX + US_LIB_EXT; };
+        auto const bundleA = InstallLib(context, "TestBundleA");
+
+        std::vector<long> installedIds;
+        auto token = context.AddBundleListener(
+            [&installedIds](BundleEvent const& evt)
+            {
+                if (evt.GetType() == BundleEvent::BUNDLE_INSTALLED)
+                {
+                    installedIds.push_back(evt.GetBundle().GetBundleId());
+                }
+            });
+        std::vector<std::string> const locations
+            = { libPath("TestBundleA2"), libPath("TestBundleA"), libPath("TestBundleM"), libPath("TestBundleA2") };
+        auto const bundles = context.InstallBundles(locations);
+        context.RemoveListener(std::move(token));
+
+        // Bundles are returned in the order of the locations, already installed
+        // and repeated locations return the installed bundles.
+        ASSERT_EQ(bundles.size(), 4u);
+        EXPECT_EQ(bundles[0].GetSymbolicName(), "TestBundleA2");
+        EXPECT_EQ(bundles[1].GetBundleId(), bundleA.GetBundleId());
+        EXPECT_EQ(bundles[2].GetSymbolicName(), "TestBundleM");
+        EXPECT_EQ(bundles[3].GetBundleId(), bundles[0].GetBundleId());
+
+        // New bundles get their ids and events in the order of the locations.
+        EXPECT_LT(bundles[0].GetBundleId(), bundles[2].GetBundleId());
+        EXPECT_EQ(installedIds, (std::vector<long> { bundles[0].GetBundleId(), bundles[2].GetBundleId() }));
+
+        // If one location fails, none of the new bundles is installed.
+        auto const installedCount = context.GetBundles().size();
+        std::vector<std::string> const failingLocations = { libPath("TestBundleLQ"), libPath("TestBundleADuplicate") };
+        EXPECT_THROW(context.InstallBundles(failingLocations), std::runtime_error);
+        EXPECT_EQ(context.GetBundles().size(), installedCount);
+        EXPECT_TRUE(context.GetBundles(libPath("TestBundleLQ")).empty());
+    }
+
+    // Install a test bundle with an injected manifest declaring its start dependencies.
+    static Bundle
+    InstallWithStartDependencies(BundleContext& context, std::string const& name, Any const& dependencies)
+    {
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        AnyMap::unordered_any_cimap manifest = {
+            {        Constants::BUNDLE_SYMBOLICNAME, name},
+            {          Constants::BUNDLE_ACTIVATOR, true},
+            {Constants::BUNDLE_STARTDEPENDENCIES, dependencies}
+        };
+        manifests[name] = AnyMap(manifest);
+        auto const location = LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + name + US_LIB_POSTFIX + US_LIB_EXT;
+        return context.InstallBundles(location, manifests).at(0);
+    }
+
+    TEST_F(BundleTest, TestStartBundlesInDependencyOrder)
+    {
+        auto const bundleA
+            = InstallWithStartDependencies(context, "TestBundleA", std::vector<Any> { std::string("TestBundleM") });
+        auto const bundleM = InstallLib(context, "TestBundleM");
+        auto const bundleStartFail = InstallLib(context, "TestBundleStartFail");
+
+        std::mutex startedMutex;
+        std::vector<std::string> started;
+        auto token = context.AddBundleListener(
+            [&](BundleEvent const& evt)
+            {
+                if (evt.GetType() == BundleEvent::BUNDLE_STARTED)
+                {
+                    std::lock_guard<std::mutex> lock(startedMutex);
+                    started.push_back(evt.GetBundle().GetSymbolicName());
+                }
+            });
+
+        // A failing bundle does not keep the others from starting, its
+        // exception is rethrown once all bundles were processed.
+        EXPECT_THROW(framework.StartBundles({ bundleStartFail, bundleA, bundleM }), std::runtime_error);
+        context.RemoveListener(std::move(token));
+
+        EXPECT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+        EXPECT_EQ(bundleM.GetState(), Bundle::STATE_ACTIVE);
+        EXPECT_EQ(bundleStartFail.GetState(), Bundle::STATE_RESOLVED);
+        EXPECT_EQ(started, (std::vector<std::string> { "TestBundleM", "TestBundleA" }));
+    }
+
+    TEST_F(BundleTest, TestStartBundlesRejectsInvalidDependencies)
+    {
+        auto const bundleA = InstallWithStartDependencies(context, "TestBundleA", std::string("TestBundleA2"));
+        auto const bundleA2 = InstallWithStartDependencies(context, "TestBundleA2", std::string("TestBundleA"));
+
+        // Cyclic dependencies are rejected before any bundle is started.
+        EXPECT_THROW(framework.StartBundles({ bundleA, bundleA2 }), std::invalid_argument);
+        EXPECT_NE(bundleA.GetState(), Bundle::STATE_ACTIVE);
+        EXPECT_NE(bundleA2.GetState(), Bundle::STATE_ACTIVE);
+
+        // Dependencies outside of the started set are ignored.
+        EXPECT_NO_THROW(framework.StartBundles({ bundleA }));
+        EXPECT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+
+        auto const bundleM = InstallWithStartDependencies(context, "TestBundleM", 42);
+        EXPECT_THROW(framework.StartBundles({ bundleM }), std::invalid_argument);
+        EXPECT_NE(bundleM.GetState(), Bundle::STATE_ACTIVE);
+    }
+#endif
+
+#if defined(US_BUILD_SHARED_LIBS) && defined(US_ENABLE_THREADING_SUPPORT)
+    TEST_F(BundleTest, TestPreloadBundleLibrary)
+    {
+        FrameworkConfiguration frameworkConfig;
+        frameworkConfig[Constants::FRAMEWORK_BUNDLE_PRELOAD] = true;
+        auto preloadingFramework = FrameworkFactory().NewFramework(frameworkConfig);
+        preloadingFramework.Start();
+        auto preloadingContext = preloadingFramework.GetBundleContext();
+
+        std::promise<FrameworkEvent> preloaded;
+        auto token = preloadingContext.AddFrameworkListener(
+            [&preloaded](FrameworkEvent const& evt)
+            {
+                if (evt.GetType() == FrameworkEvent::Type::FRAMEWORK_INFO
+                    && evt.GetMessage().find("Preloaded shared library") != std::string::npos)
+                {
+                    preloaded.set_value(evt);
+                }
+            });
+
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        AnyMap::unordered_any_cimap manifest = {
+            {Constants::BUNDLE_SYMBOLICNAME, std::string("TestBundleA")},
+            {   Constants::BUNDLE_ACTIVATOR,                       true},
+            {     Constants::BUNDLE_PRELOAD,                       true}
+        };
+        manifests["TestBundleA"] = AnyMap(manifest);
+        auto const location = LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + "TestBundleA" + US_LIB_POSTFIX + US_LIB_EXT;
+        auto bundle = preloadingContext.InstallBundles(location, manifests).at(0);
+
+        auto preloadedEvent = preloaded.get_future();
+        ASSERT_EQ(preloadedEvent.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+        EXPECT_EQ(preloadedEvent.get().GetBundle(), bundle);
+
+        bundle.Start();
+        EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+
+        preloadingContext.RemoveListener(std::move(token));
+        preloadingFramework.Stop();
+        preloadingFramework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    TEST_F(BundleTest, TestPreloadValidatesOnStart)
+    {
+        // The validation function runs once, when the bundle is started, and
+        // not on the preloading thread.
+        std::mutex validationMutex;
+        std::vector<std::thread::id> validatingThreads;
+        std::function<bool(Bundle const&)> validationFunc = [&](Bundle const&)
+        {
+            std::lock_guard<std::mutex> lock(validationMutex);
+            validatingThreads.push_back(std::this_thread::get_id());
+            return true;
+        };
+        FrameworkConfiguration frameworkConfig;
+        frameworkConfig[Constants::FRAMEWORK_BUNDLE_PRELOAD] = true;
+        frameworkConfig[Constants::FRAMEWORK_BUNDLE_VALIDATION_FUNC] = validationFunc;
+        auto preloadingFramework = FrameworkFactory().NewFramework(frameworkConfig);
+        preloadingFramework.Start();
+        auto preloadingContext = preloadingFramework.GetBundleContext();
+
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        AnyMap::unordered_any_cimap manifest = {
+            {Constants::BUNDLE_SYMBOLICNAME, std::string("TestBundleA")},
+            {   Constants::BUNDLE_ACTIVATOR,                       true},
+            {     Constants::BUNDLE_PRELOAD,                       true}
+        };
+        manifests["TestBundleA"] = AnyMap(manifest);
+        auto const location = LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + "TestBundleA" + US_LIB_POSTFIX + US_LIB_EXT;
+        auto bundle = preloadingContext.InstallBundles(location, manifests).at(0);
+        bundle.Start();
+        EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+
+        preloadingFramework.Stop();
+        preloadingFramework.WaitForStop(std::chrono::milliseconds::zero());
+
+        std::lock_guard<std::mutex> lock(validationMutex);
+        ASSERT_EQ(validatingThreads.size(), 1u);
+        EXPECT_EQ(validatingThreads.front(), std::this_thread::get_id());
+    }
+
+    TEST_F(BundleTest, TestFastShutdown)
+    {
+        FrameworkConfiguration frameworkConfig;
+        frameworkConfig[Constants::FRAMEWORK_FAST_SHUTDOWN] = true;
+        auto fastFramework = FrameworkFactory().NewFramework(frameworkConfig);
+        fastFramework.Start();
+        auto fastContext = fastFramework.GetBundleContext();
+
+        auto bundleA
+            = InstallWithStartDependencies(fastContext, "TestBundleA", std::vector<Any> { std::string("TestBundleM") });
+        auto bundleM = InstallLib(fastContext, "TestBundleM");
+        bundleM.Start();
+        bundleA.Start();
+
+        std::mutex eventsMutex;
+        std::vector<std::string> stopped;
+        std::size_t unregistering = 0;
+        fastContext.AddBundleListener(
+            [&](BundleEvent const& evt)
+            {
+                if (evt.GetType() == BundleEvent::BUNDLE_STOPPED)
+                {
+                    std::lock_guard<std::mutex> lock(eventsMutex);
+                    stopped.push_back(evt.GetBundle().GetSymbolicName());
+                }
+            });
+        fastContext.AddServiceListener(
+            [&](ServiceEvent const& evt)
+            {
+                if (evt.GetType() == ServiceEvent::SERVICE_UNREGISTERING)
+                {
+                    std::lock_guard<std::mutex> lock(eventsMutex);
+                    ++unregistering;
+                }
+            });
+
+        // Listeners of a stopping bundle miss the events sent while it stops.
+        std::vector<std::string> seenByM;
+        bundleM.GetBundleContext().AddBundleListener(
+            [&](BundleEvent const& evt)
+            {
+                if (evt.GetType() == BundleEvent::BUNDLE_STOPPING && evt.GetBundle().GetBundleId() != 0)
+                {
+                    std::lock_guard<std::mutex> lock(eventsMutex);
+                    seenByM.push_back(evt.GetBundle().GetSymbolicName());
+                }
+            });
+
+        fastFramework.Stop();
+        fastFramework.WaitForStop(std::chrono::milliseconds::zero());
+
+        // A bundle is stopped after the bundles depending on it and the
+        // framework's own listeners still get all events.
+        EXPECT_EQ(stopped, (std::vector<std::string> { "TestBundleA", "TestBundleM" }));
+        EXPECT_EQ(unregistering, 1u);
+        EXPECT_EQ(seenByM, std::vector<std::string> { "TestBundleA" });
+        EXPECT_EQ(bundleA.GetState(), Bundle::STATE_INSTALLED);
+        EXPECT_EQ(bundleM.GetState(), Bundle::STATE_INSTALLED);
+    }
+#endif
+
     TEST_F(BundleTest, TestBundleStreamOperator)
     {
         auto const bundle = InstallLib(context, "TestBundleA");
@@ -20,14 +20,18 @@ limitations under the License.
 
 =============================================================================*/
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
+#include <set>
 #include <thread>
 #include <type_traits>
 
 #include "TestUtilBundleListener.h"
 #include "TestUtils.h"
+#include "TestingConfig.h"
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleEvent.h"
@@ -41,6 +45,7 @@ limitations under the License.
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "json/json.h"
 
 #ifdef US_PLATFORM_POSIX
 #    include <dlfcn.h>
@@ -323,6 +328,392 @@ TEST(FrameworkTest, TempDataDirIsNotCreatedWhenFrameworkStarts)
     framework.WaitForStop(std::chrono::milliseconds::zero());
 }
 
+TEST(FrameworkTest, BundleCacheRestoresInstalledBundles)
+{
+    TempDir frameworkStorage = MakeUniqueTempDirectory();
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STORAGE] = static_cast<std::string>(frameworkStorage);
+    frameworkConfig[Constants::FRAMEWORK_BUNDLE_CACHE] = true;
+
+    long bundleId = -1;
+    std::string location;
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        framework.Start();
+        auto bundle = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleA");
+        bundle.Start();
+        bundleId = bundle.GetBundleId();
+        location = bundle.GetLocation();
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        framework.Start();
+        auto context = framework.GetBundleContext();
+        auto bundles = context.GetBundles(location);
+        auto bundle = std::find_if(bundles.begin(),
+                                   bundles.end(),
+                                   [](Bundle const& b) { return b.GetSymbolicName() == "TestBundleA"; });
+        ASSERT_NE(bundle, bundles.end()) << "The cached bundle was not installed on init";
+        EXPECT_EQ(bundle->GetBundleId(), bundleId);
+        EXPECT_EQ(bundle->GetHeaders().at(Constants::BUNDLE_SYMBOLICNAME).ToString(), "TestBundleA");
+        EXPECT_EQ(bundle->GetState(), Bundle::STATE_ACTIVE) << "The cached bundle was not started on launch";
+
+        // Installing the same location again returns the cached bundle.
+        auto reinstalled = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+        EXPECT_EQ(reinstalled.GetBundleId(), bundleId);
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    frameworkConfig[Constants::FRAMEWORK_STORAGE_CLEAN] = Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT;
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        framework.Start();
+        auto bundles = framework.GetBundleContext().GetBundles(location);
+        EXPECT_TRUE(std::none_of(bundles.begin(),
+                                 bundles.end(),
+                                 [](Bundle const& b) { return b.GetSymbolicName() == "TestBundleA"; }))
+            << "Cleaning the storage did not discard the cached bundle";
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+}
+
+#if defined(US_BUILD_SHARED_LIBS)
+TEST(FrameworkTest, StartLevels)
+{
+    auto f = FrameworkFactory().NewFramework();
+    f.Start();
+    EXPECT_EQ(f.GetStartLevel(), 1);
+    auto context = f.GetBundleContext();
+
+    auto install = [&context](std::string const& name, int startLevel)
+    {
+        AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        AnyMap::unordered_any_cimap manifest = {
+            {Constants::BUNDLE_SYMBOLICNAME,       name},
+            {   Constants::BUNDLE_ACTIVATOR,       true},
+            {  Constants::BUNDLE_STARTLEVEL, startLevel}
+        };
+        manifests[name] = AnyMap(manifest);
+        return context
+            .InstallBundles(cppmicroservices::testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + name
+                                + US_LIB_POSTFIX + US_LIB_EXT,
+                            manifests)
+            .at(0);
+    };
+
+    EXPECT_THROW(install("TestBundleH", 0), std::runtime_error);
+    auto bundleM = cppmicroservices::testing::InstallLib(context, "TestBundleM");
+    auto bundleA = install("TestBundleA", 2);
+    auto bundleA2 = install("TestBundleA2", 3);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> messages;
+    auto token = context.AddFrameworkListener(
+        [&](FrameworkEvent const& evt)
+        {
+            if (evt.GetType() == FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                messages.push_back(evt.GetMessage());
+                cv.notify_all();
+            }
+        });
+    auto changeStartLevel = [&](int startLevel, std::size_t events)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.clear();
+        }
+        f.SetStartLevel(startLevel);
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(10), [&] { return messages.size() == events; });
+    };
+
+    // Explicitly started bundles are marked to be started on their start level.
+    f.StartBundles({ bundleM, bundleA, bundleA2 });
+    ASSERT_TRUE(changeStartLevel(3, 1));
+    EXPECT_EQ(f.GetStartLevel(), 3);
+
+    // Lowering the start level stops the bundles level by level.
+    ASSERT_TRUE(changeStartLevel(1, 2));
+    EXPECT_EQ(messages[0].rfind("Start level 2 reached", 0), 0u) << messages[0];
+    EXPECT_EQ(messages[1].rfind("Start level 1 reached", 0), 0u) << messages[1];
+    EXPECT_EQ(f.GetStartLevel(), 1);
+    EXPECT_EQ(bundleM.GetState(), Bundle::STATE_ACTIVE);
+    EXPECT_EQ(bundleA.GetState(), Bundle::STATE_RESOLVED);
+    EXPECT_EQ(bundleA2.GetState(), Bundle::STATE_RESOLVED);
+
+    // Raising it again starts them level by level.
+    ASSERT_TRUE(changeStartLevel(3, 2));
+    EXPECT_EQ(messages[0].rfind("Start level 2 reached", 0), 0u) << messages[0];
+    EXPECT_EQ(messages[1].rfind("Start level 3 reached", 0), 0u) << messages[1];
+    EXPECT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+    EXPECT_EQ(bundleA2.GetState(), Bundle::STATE_ACTIVE);
+
+    context.RemoveListener(std::move(token));
+    EXPECT_THROW(f.SetStartLevel(0), std::invalid_argument);
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+    EXPECT_EQ(f.GetStartLevel(), 0);
+    EXPECT_THROW(f.SetStartLevel(2), std::logic_error);
+
+    FrameworkConfiguration config;
+    config[Constants::FRAMEWORK_BEGINNING_STARTLEVEL] = std::string("2");
+    auto f2 = FrameworkFactory().NewFramework(config);
+    f2.Start();
+    EXPECT_EQ(f2.GetStartLevel(), 2);
+    f2.Stop();
+    f2.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
+#if defined(US_BUILD_SHARED_LIBS)
+TEST(FrameworkTest, StartLevelActivationOrder)
+{
+    auto checkActivation = [](bool concurrent)
+    {
+        FrameworkConfiguration config;
+        if (concurrent)
+        {
+            config[Constants::FRAMEWORK_STARTLEVEL_CONCURRENT] = true;
+        }
+        auto f = FrameworkFactory().NewFramework(config);
+        f.Start();
+        auto context = f.GetBundleContext();
+
+        std::vector<Bundle> bundles;
+        for (auto const& name : { "TestBundleA", "TestBundleA2", "TestBundleM" })
+        {
+            AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            AnyMap::unordered_any_cimap manifest = {
+                {Constants::BUNDLE_SYMBOLICNAME, std::string(name)},
+                {  Constants::BUNDLE_STARTLEVEL,                 2}
+            };
+            manifests[name] = AnyMap(manifest);
+            bundles.push_back(context
+                                  .InstallBundles(cppmicroservices::testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX
+                                                      + name + US_LIB_POSTFIX + US_LIB_EXT,
+                                                  manifests)
+                                  .at(0));
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<long> started;
+        std::set<std::thread::id> threads;
+        std::size_t levelChanges = 0;
+        auto bundleToken = context.AddBundleListener(
+            [&](BundleEvent const& evt)
+            {
+                if (evt.GetType() == BundleEvent::BUNDLE_STARTING)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    started.push_back(evt.GetBundle().GetBundleId());
+                    threads.insert(std::this_thread::get_id());
+                }
+            });
+        auto frameworkToken = context.AddFrameworkListener(
+            [&](FrameworkEvent const& evt)
+            {
+                if (evt.GetType() == FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++levelChanges;
+                    cv.notify_all();
+                }
+            });
+        auto changeStartLevel = [&](int startLevel)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto const expected = levelChanges + 1;
+            started.clear();
+            threads.clear();
+            lock.unlock();
+            f.SetStartLevel(startLevel);
+            lock.lock();
+            return cv.wait_for(lock, std::chrono::seconds(10), [&] { return levelChanges == expected; });
+        };
+
+        // Explicitly started bundles are marked to be started on their start
+        // level, lowering the start level stops them again.
+        f.StartBundles(bundles);
+        ASSERT_TRUE(changeStartLevel(2));
+        ASSERT_TRUE(changeStartLevel(1));
+
+        ASSERT_TRUE(changeStartLevel(2));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            EXPECT_EQ(started.size(), bundles.size());
+            if (!concurrent)
+            {
+                // one bundle after the other, in bundle id order
+                EXPECT_EQ(threads.size(), 1u);
+                EXPECT_TRUE(std::is_sorted(started.begin(), started.end()));
+            }
+        }
+        for (auto const& bundle : bundles)
+        {
+            EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+        }
+
+        context.RemoveListener(std::move(bundleToken));
+        context.RemoveListener(std::move(frameworkToken));
+        f.Stop();
+        f.WaitForStop(std::chrono::milliseconds::zero());
+    };
+
+    checkActivation(false);
+    checkActivation(true);
+}
+
+TEST(FrameworkTest, StopWhileChangingStartLevel)
+{
+    auto f = FrameworkFactory().NewFramework();
+    f.Start();
+    auto context = f.GetBundleContext();
+    AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    manifests["TestBundleA"] = AnyMap(AnyMap::unordered_any_cimap {
+        {Constants::BUNDLE_SYMBOLICNAME, std::string("TestBundleA")},
+        {  Constants::BUNDLE_STARTLEVEL,                           2}
+    });
+    auto bundle = context
+                      .InstallBundles(cppmicroservices::testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX
+                                          + "TestBundleA" + US_LIB_POSTFIX + US_LIB_EXT,
+                                      manifests)
+                      .at(0);
+    f.StartBundles({ bundle });
+
+    // the start level changes are joined by the shutdown, whether they
+    // completed or not
+    f.SetStartLevel(1);
+    f.SetStartLevel(2);
+    f.Stop();
+    auto const evt = f.WaitForStop(std::chrono::milliseconds::zero());
+    EXPECT_EQ(evt.GetType(), FrameworkEvent::Type::FRAMEWORK_STOPPED);
+}
+
+TEST(FrameworkTest, NonBooleanConcurrentStartLevel)
+{
+    // A bad value falls back to the default instead of failing on the start
+    // level thread.
+    FrameworkConfiguration config;
+    config[Constants::FRAMEWORK_STARTLEVEL_CONCURRENT] = std::string("true");
+    auto f = FrameworkFactory().NewFramework(config);
+    f.Start();
+    auto context = f.GetBundleContext();
+    EXPECT_FALSE(any_cast<bool>(context.GetProperty(Constants::FRAMEWORK_STARTLEVEL_CONCURRENT)));
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool changed = false;
+    auto token = context.AddFrameworkListener(
+        [&](FrameworkEvent const& evt)
+        {
+            if (evt.GetType() == FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                changed = true;
+                cv.notify_all();
+            }
+        });
+    f.SetStartLevel(2);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(10), [&] { return changed; }));
+    }
+    EXPECT_EQ(f.GetStartLevel(), 2);
+
+    context.RemoveListener(std::move(token));
+    f.Stop();
+    f.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
+#if defined(US_BUILD_SHARED_LIBS)
+TEST(FrameworkTest, StartupTrace)
+{
+    TempDir traceDir = MakeUniqueTempDirectory();
+    auto const tracePath = static_cast<std::string>(traceDir) + util::DIR_SEP + "startup.json";
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STARTUP_TRACE] = tracePath;
+
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    framework.Init();
+    auto context = framework.GetBundleContext();
+    auto token = context.AddBundleListener([](BundleEvent const&) {});
+    auto bundle = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+    bundle.Start();
+    framework.Start();
+
+    auto const readTrace = [&tracePath](Json::Value& root)
+    {
+        std::ifstream trace(tracePath);
+        ASSERT_TRUE(trace.is_open()) << "The start-up trace was not written";
+        Json::Reader reader;
+        ASSERT_TRUE(reader.parse(trace, root)) << reader.getFormattedErrorMessages();
+        ASSERT_TRUE(root["traceEvents"].isArray());
+    };
+
+    // The trace is written once the framework has started.
+    Json::Value root;
+    readTrace(root);
+
+    // Nothing is recorded after start-up.
+    auto bundleA2 = cppmicroservices::testing::InstallLib(context, "TestBundleA2");
+    bundleA2.Start();
+    context.RemoveListener(std::move(token));
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+    Json::Value rootAfterStop;
+    readTrace(rootAfterStop);
+    ASSERT_EQ(rootAfterStop["traceEvents"].size(), root["traceEvents"].size());
+
+    std::set<std::string> names;
+    for (auto const& event : root["traceEvents"])
+    {
+        EXPECT_EQ(event["ph"].asString(), "X");
+        EXPECT_TRUE(event["ts"].isNumeric());
+        EXPECT_GE(event["dur"].asDouble(), 0.0);
+        EXPECT_GE(event["tid"].asInt(), 1);
+        names.insert(event["name"].asString());
+        if (event["name"].asString() == "Load library")
+        {
+            EXPECT_EQ(event["args"]["bundle"].asString(), "TestBundleA");
+        }
+    }
+    for (auto const& name : { "Framework::Init",
+                              "Framework::Start",
+                              "Scan bundle file",
+                              "Install",
+                              "Parse manifest",
+                              "Load library",
+                              "BundleActivator::Start",
+                              "Bundle listener",
+                              "RegisterService" })
+    {
+        EXPECT_EQ(names.count(name), 1u) << name << " is missing in the start-up trace";
+    }
+}
+
+TEST(FrameworkTest, StartupTraceWithInvalidPath)
+{
+    // A trace path which is not a string is ignored.
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STARTUP_TRACE] = 42;
+
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start());
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
 TEST(FrameworkTest, DefaultLogSink)
 {
     FrameworkConfiguration configuration;
@@ -410,7 +410,7 @@ namespace cppmicroservices
     class MockBundleStorageFile : public cppmicroservices::BundleStorageFile
     {
       public:
-        MockBundleStorageFile() : BundleStorageFile() {}
+        MockBundleStorageFile(const std::string & storagePath, bool cleanStorage) : BundleStorageFile(storagePath, cleanStorage) {}
         MOCK_METHOD3(CreateAndInsertArchive, std::shared_ptr<BundleArchive>(const std::shared_ptr<BundleResourceContainer> &, const std::string &, const ManifestT &));
         MOCK_METHOD1(RemoveArchive, bool(const BundleArchive *));
         // TODO: MOCK_METHOD0(GetAllBundleArchives, std::vector<std::shared_ptr<BundleArchive>>());
@@ -740,8 +740,10 @@ namespace cppmicroservices
       public:
         MOCK_METHOD0(Clear, void());
         MOCK_METHOD5(CreateServiceProperties, Properties(const ServiceProperties &, const std::vector<std::string> &, bool, bool, long));
+        MOCK_METHOD5(CreateServiceProperties, Properties(ServiceProperties &&, const std::vector<std::string> &, bool, bool, long));
         MockServiceRegistry(CoreBundleContext * coreCtx) : ServiceRegistry(coreCtx) {}
         MOCK_METHOD3(RegisterService, ServiceRegistrationBase(BundlePrivate *, const InterfaceMapConstPtr &, const ServiceProperties &));
+        MOCK_METHOD3(RegisterService, ServiceRegistrationBase(BundlePrivate *, const InterfaceMapConstPtr &, ServiceProperties &&));
         MOCK_METHOD1(UpdateServiceRegistrationOrder, void(const std::vector<std::string> &));
         MOCK_METHOD2(Get, void(const std::string &, std::vector<ServiceRegistrationBase> &));
         MOCK_METHOD2(Get, ServiceReferenceBase(BundlePrivate *, const std::string &));
@@ -46,6 +46,40 @@ namespace cppmicroservices
         EXPECT_THROW({ Properties props(map); }, std::runtime_error);
     }
 
+    /*
+     * Properties constructed from a pre-validated map must not validate again.
+     */
+    TEST_F(PropertiesTest, PreValidated)
+    {
+        Properties props(AnyMap(AnyMap::UNORDERED_MAP, { { "hello", std::string("world") } }),
+                         Properties::PreValidated {});
+        auto result = props.Value_unlocked("HELLO", false);
+        ASSERT_TRUE(result.second);
+        ASSERT_EQ(any_cast<std::string>(result.first), "world");
+
+        // Case variants are only caught on the validating path.
+        AnyMap const variants(AnyMap::UNORDERED_MAP,
+                              { { "hello", std::string("world") }, { "HELLO", std::string("WORLD") } });
+        EXPECT_THROW({ Properties validated(variants); }, std::runtime_error);
+        EXPECT_NO_THROW({ Properties unchecked(AnyMap(variants), Properties::PreValidated {}); });
+    }
+
+    /*
+     * Case variants are found among many keys, wherever they are.
+     */
+    TEST_F(PropertiesTest, ValidationFailureManyKeys)
+    {
+        AnyMap map(AnyMap::UNORDERED_MAP);
+        for (int i = 0; i < 100; ++i)
+        {
+            map["key" + std::to_string(i)] = i;
+        }
+        EXPECT_NO_THROW({ Properties props(map); });
+
+        map["KEY99"] = 0;
+        EXPECT_THROW({ Properties props(map); }, std::runtime_error);
+    }
+
     /*
      * Test Value behavior with all four branch paths based on input
      * AnyMap type.
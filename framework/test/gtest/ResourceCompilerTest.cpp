@@ -423,6 +423,59 @@ TEST_F(ResourceCompilerTest, testManifestResAdd)
     testExists(entryNames, "mybundle/resource1/");
 }
 
+/*
+ * Use resource compiler to create zip files containing the binary form of the
+ * manifest, once through --manifest-add and once through --res-add.
+ *
+ * Working directory is changed temporarily to tempdir because of --res-add option
+ */
+TEST_F(ResourceCompilerTest, testBinaryManifest)
+{
+    createDirHierarchy(tempdir, manifest_json);
+
+    std::ostringstream cmd;
+    cmd << rcbinpath;
+    cmd << " --bundle-name mybundle";
+    cmd << " --out-file " << tempdir << "ExampleBinaryManifest.zip";
+    cmd << " --manifest-add " << tempdir << "manifest.json";
+    cmd << " --binary-manifest";
+    ASSERT_EQ(EXIT_SUCCESS, runExecutable(cmd.str()));
+
+    ZipFile zip(tempdir + "ExampleBinaryManifest.zip");
+    ASSERT_EQ(zip.size(), 3);
+    auto entryNames = zip.getNames();
+    testExists(entryNames, "mybundle/manifest.json");
+    testExists(entryNames, "mybundle/manifest.bin");
+    testExists(entryNames, "mybundle/");
+    for (std::size_t i = 0; i < zip.size(); ++i)
+    {
+        if (zip[i].name == "mybundle/manifest.bin")
+        {
+            // The binary manifest is stored, not compressed.
+            ASSERT_EQ(zip[i].compressedSize, zip[i].uncompressedSize);
+        }
+    }
+
+    cmd.str(std::string());
+    cmd << rcbinpath;
+    cmd << " --bundle-name mybundle";
+    cmd << " --out-file ExampleBinaryManifestResAdd.zip";
+    cmd << " --res-add manifest.json";
+    cmd << " --binary-manifest";
+
+    auto cwdir = GetCurrentWorkingDirectory();
+    ChangeDirectory(tempdir);
+    ASSERT_EQ(EXIT_SUCCESS, runExecutable(cmd.str()));
+    ChangeDirectory(cwdir);
+
+    zip = ZipFile(tempdir + "ExampleBinaryManifestResAdd.zip");
+    ASSERT_EQ(zip.size(), 3);
+    entryNames = zip.getNames();
+    testExists(entryNames, "mybundle/manifest.json");
+    testExists(entryNames, "mybundle/manifest.bin");
+    testExists(entryNames, "mybundle/");
+}
+
 /*
  * Use resource compiler to create tomerge.zip with only --res-add option
  *
@@ -30,6 +30,8 @@ limitations under the License.
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/LDAPProp.h"
 #include "cppmicroservices/ListenerToken.h"
+#include "cppmicroservices/PooledPrototypeServiceFactory.h"
+#include "cppmicroservices/PrototypeServiceFactory.h"
 #include "cppmicroservices/ServiceObjects.h"
 
 #include "cppmicroservices/detail/Threads.h"
@@ -84,6 +86,21 @@ namespace
         MOCK_METHOD3(UngetService, void(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&));
     };
 
+    class MockPrototypeFactory : public PrototypeServiceFactory
+    {
+      public:
+        MOCK_METHOD2(GetService, InterfaceMapConstPtr(Bundle const&, ServiceRegistrationBase const&));
+        MOCK_METHOD3(UngetService, void(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&));
+    };
+
+    class MockPooledPrototypeFactory : public PooledPrototypeServiceFactory
+    {
+      public:
+        MOCK_METHOD2(GetService, InterfaceMapConstPtr(Bundle const&, ServiceRegistrationBase const&));
+        MOCK_METHOD3(UngetService, void(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&));
+        MOCK_METHOD3(ResetService, bool(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&));
+    };
+
 } // namespace
 
 class ServiceFactoryTest : public ::testing::Test
@@ -299,6 +316,104 @@ TEST_F(ServiceFactoryTest, TestServiceFactoryPrototypeScope)
     bundleH.Stop();
 }
 
+TEST_F(ServiceFactoryTest, TestPooledPrototypeServices)
+{
+    using ::testing::_;
+
+    auto sf = std::make_shared<MockPooledPrototypeFactory>();
+    EXPECT_CALL(*sf, GetService(_, _))
+        .Times(3)
+        .WillRepeatedly([](Bundle const&, ServiceRegistrationBase const&)
+                        { return MakeInterfaceMap<ITestServiceA>(std::make_shared<TestServiceAImpl>()); });
+    EXPECT_CALL(*sf, ResetService(_, _, _)).Times(4).WillRepeatedly(::testing::Return(true));
+    // one instance does not fit into the pool, the two pooled ones are released on unregistration
+    EXPECT_CALL(*sf, UngetService(_, _, _)).Times(3);
+
+    auto reg = context.RegisterService<ITestServiceA>(ToFactory(sf),
+                                                      {
+                                                          {Constants::SERVICE_PROTOTYPE_POOL_SIZE, Any(2)}
+    });
+    auto serviceObjects = context.GetServiceObjects(reg.GetReference());
+
+    // released instances are reused
+    std::shared_ptr<ITestServiceA> first = serviceObjects.GetService();
+    ASSERT_TRUE(first);
+    auto* firstPtr = first.get();
+    first.reset();
+    std::shared_ptr<ITestServiceA> reused = serviceObjects.GetService();
+    ASSERT_EQ(reused.get(), firstPtr);
+
+    // the pool holds at most two released instances
+    auto second = serviceObjects.GetService();
+    auto third = serviceObjects.GetService();
+    ASSERT_NE(second, reused);
+    ASSERT_NE(third, reused);
+    ASSERT_NE(second, third);
+    reused.reset();
+    second.reset();
+    third.reset();
+
+    // the void ServiceObjects hand out copies of the pooled instance's map
+    auto voidServiceObjects = context.GetServiceObjects(ServiceReferenceU(reg.GetReference()));
+    auto interfaceMap = voidServiceObjects.GetService();
+    ASSERT_TRUE(interfaceMap);
+    interfaceMap.reset();
+
+    reg.Unregister();
+}
+
+TEST_F(ServiceFactoryTest, TestPooledPrototypeServiceResetFails)
+{
+    using ::testing::_;
+
+    auto sf = std::make_shared<MockPooledPrototypeFactory>();
+    EXPECT_CALL(*sf, GetService(_, _))
+        .Times(2)
+        .WillRepeatedly([](Bundle const&, ServiceRegistrationBase const&)
+                        { return MakeInterfaceMap<ITestServiceA>(std::make_shared<TestServiceAImpl>()); });
+    EXPECT_CALL(*sf, ResetService(_, _, _))
+        .Times(2)
+        .WillOnce(::testing::Return(false))
+        .WillOnce(::testing::Throw(std::runtime_error("reset failed")));
+    EXPECT_CALL(*sf, UngetService(_, _, _)).Times(2);
+
+    auto reg = context.RegisterService<ITestServiceA>(ToFactory(sf),
+                                                      {
+                                                          {Constants::SERVICE_PROTOTYPE_POOL_SIZE, Any(4)}
+    });
+    auto serviceObjects = context.GetServiceObjects(reg.GetReference());
+
+    // instances which could not be reset are handed back to the factory
+    (void)serviceObjects.GetService();
+    (void)serviceObjects.GetService();
+
+    reg.Unregister();
+}
+
+TEST_F(ServiceFactoryTest, TestPrototypeServicesWithoutResetAreNotPooled)
+{
+    using ::testing::_;
+
+    auto sf = std::make_shared<MockPrototypeFactory>();
+    EXPECT_CALL(*sf, GetService(_, _))
+        .Times(2)
+        .WillRepeatedly([](Bundle const&, ServiceRegistrationBase const&)
+                        { return MakeInterfaceMap<ITestServiceA>(std::make_shared<TestServiceAImpl>()); });
+    EXPECT_CALL(*sf, UngetService(_, _, _)).Times(2);
+
+    auto reg = context.RegisterService<ITestServiceA>(ToFactory(sf),
+                                                      {
+                                                          {Constants::SERVICE_PROTOTYPE_POOL_SIZE, Any(2)}
+    });
+    auto serviceObjects = context.GetServiceObjects(reg.GetReference());
+
+    // the pool size property is ignored for factories without a reset hook
+    (void)serviceObjects.GetService();
+    (void)serviceObjects.GetService();
+
+    reg.Unregister();
+}
+
 TEST_F(ServiceFactoryTest, TestServiceFactoryBundleScope)
 {
 
@@ -404,6 +519,88 @@ TEST_F(ServiceFactoryTest, TestConcurrentServiceFactory)
     for (auto& t : worker_threads)
         t.join();
 }
+
+// test that concurrent first requests from the same bundle for a bundle scope
+// service call ServiceFactory::GetService exactly once and share its result.
+TEST_F(ServiceFactoryTest, TestConcurrentBundleScopeServiceCreation)
+{
+    auto sf = std::make_shared<MockFactory>();
+    EXPECT_CALL(*sf, GetService(::testing::_, ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Invoke(
+            [](Bundle const&, ServiceRegistrationBase const&)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                return MakeInterfaceMap<ITestServiceA>(std::make_shared<TestServiceAImpl>());
+            }));
+    EXPECT_CALL(*sf, UngetService(::testing::_, ::testing::_, ::testing::_)).Times(1);
+
+    auto reg = context.RegisterService<ITestServiceA>(ToFactory(sf));
+    auto sref = context.GetServiceReference<ITestServiceA>();
+    ASSERT_TRUE(static_cast<bool>(sref));
+
+    std::promise<void> go;
+    std::shared_future<void> ready(go.get_future());
+    std::vector<std::future<std::shared_ptr<ITestServiceA>>> requests;
+    for (int i = 0; i < 8; ++i)
+    {
+        requests.push_back(std::async(std::launch::async,
+                                      [this, ready, sref]()
+                                      {
+                                          ready.wait();
+                                          return context.GetService<ITestServiceA>(sref);
+                                      }));
+    }
+    go.set_value();
+
+    std::vector<std::shared_ptr<ITestServiceA>> services;
+    for (auto& request : requests)
+    {
+        services.push_back(request.get());
+        ASSERT_NE(services.back(), nullptr);
+        // every caller must observe the single instance created by the factory
+        ASSERT_EQ(services.back(), services.front());
+    }
+
+    // releasing the last use of the bundle scope service ungets it exactly once
+    services.clear();
+    reg.Unregister();
+}
+
+// test that a request from another thread, made while ServiceFactory::GetService
+// runs for the same bundle, blocks until the factory returns and shares its result.
+// The factory must not wait for such a request, which would deadlock.
+TEST_F(ServiceFactoryTest, TestCrossThreadBundleScopeServiceRequest)
+{
+    std::future<std::shared_ptr<ITestServiceA>> request;
+    auto sf = std::make_shared<MockFactory>();
+    EXPECT_CALL(*sf, GetService(::testing::_, ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Invoke(
+            [this, &request](Bundle const&, ServiceRegistrationBase const& registration)
+            {
+                auto sref = registration.GetReference(us_service_interface_iid<ITestServiceA>());
+                request = std::async(std::launch::async,
+                                     [this, sref]()
+                                     { return context.GetService<ITestServiceA>(ServiceReference<ITestServiceA>(sref)); });
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                return MakeInterfaceMap<ITestServiceA>(std::make_shared<TestServiceAImpl>());
+            }));
+    EXPECT_CALL(*sf, UngetService(::testing::_, ::testing::_, ::testing::_)).Times(1);
+
+    auto reg = context.RegisterService<ITestServiceA>(ToFactory(sf));
+    auto sref = context.GetServiceReference<ITestServiceA>();
+    ASSERT_TRUE(static_cast<bool>(sref));
+
+    auto service = context.GetService<ITestServiceA>(sref);
+    ASSERT_NE(service, nullptr);
+    ASSERT_TRUE(request.valid());
+    ASSERT_EQ(request.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    ASSERT_EQ(request.get(), service);
+
+    service.reset();
+    reg.Unregister();
+}
 #endif
 
 TEST_F(ServiceFactoryTest, TestServiceFactoryBundleScopeErrorConditions)
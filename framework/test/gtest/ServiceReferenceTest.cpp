@@ -269,4 +269,41 @@ TEST_F(ServiceReferenceTest, TestRegisterUnregisterCompareReference)
     }
 
     ASSERT_NE(set.find(sr2), set.end());
-}
\ No newline at end of file
+}
+
+TEST_F(ServiceReferenceTest, TestCachedServicePropertyAccessors)
+{
+    auto context = framework.GetBundleContext();
+    auto reg = context.RegisterService<ServiceNS::ITestServiceA>(
+        std::make_shared<TestServiceA>(),
+        {
+            {Constants::SERVICE_RANKING, 5}
+    });
+    auto ref = reg.GetReference();
+
+    ASSERT_EQ(ref.GetServiceId(), any_cast<long>(ref.GetProperty(Constants::SERVICE_ID)));
+    ASSERT_EQ(ref.GetServiceRanking(), 5);
+    ASSERT_EQ(ref.GetObjectClasses(),
+              ref_any_cast<std::vector<std::string>>(ref.GetProperty(Constants::OBJECTCLASS)));
+    ASSERT_EQ(ref.GetServiceScope(), Constants::SCOPE_SINGLETON);
+
+    // the ranking follows property updates, and removing it resets it to 0
+    reg.SetProperties({
+        {Constants::SERVICE_RANKING, -3}
+    });
+    ASSERT_EQ(ref.GetServiceRanking(), -3);
+    reg.SetProperties(ServiceProperties {});
+    ASSERT_EQ(ref.GetServiceRanking(), 0);
+
+    // the values remain available after the service has been unregistered
+    auto id = ref.GetServiceId();
+    reg.Unregister();
+    ASSERT_EQ(ref.GetServiceId(), id);
+    ASSERT_EQ(ref.GetServiceScope(), Constants::SCOPE_SINGLETON);
+
+    ServiceReferenceU invalidRef;
+    ASSERT_EQ(invalidRef.GetServiceId(), 0);
+    ASSERT_EQ(invalidRef.GetServiceRanking(), 0);
+    ASSERT_TRUE(invalidRef.GetObjectClasses().empty());
+    ASSERT_TRUE(invalidRef.GetServiceScope().empty());
+}
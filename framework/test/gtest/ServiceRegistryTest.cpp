@@ -24,11 +24,15 @@
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/ServiceFactory.h"
 
 #include "TestUtils.h"
 #include "gtest/gtest.h"
 
+#include <future>
+#include <numeric>
 #include <unordered_set>
+#include <vector>
 
 using namespace cppmicroservices;
 
@@ -217,3 +221,179 @@ TEST_F(ServiceRegistryTest, TestServicePropertiesFailure)
     props2[Constants::SERVICE_RANKING] = std::string("Not an integer");
     EXPECT_THROW(reg1.SetProperties(props2), std::invalid_argument);
 }
+
+TEST_F(ServiceRegistryTest, TestMovedServiceProperties)
+{
+    auto s1 = std::make_shared<TestServiceA>();
+    ServiceProperties props;
+    props["string"] = std::string("A std::string");
+    props[Constants::SERVICE_RANKING] = 10;
+
+    ServiceRegistration<ITestServiceA> reg1 = context.RegisterService<ITestServiceA>(s1, std::move(props));
+    ServiceReference<ITestServiceA> ref1 = reg1.GetReference();
+
+    ASSERT_EQ(any_cast<std::string>(ref1.GetProperty("string")), "A std::string");
+    ASSERT_EQ(any_cast<int>(ref1.GetProperty(Constants::SERVICE_RANKING)), 10);
+    ASSERT_EQ(ref1.GetProperty(Constants::SERVICE_SCOPE).ToString(), Constants::SCOPE_SINGLETON);
+    ASSERT_FALSE(ref1.GetProperty(Constants::SERVICE_ID).Empty());
+    ASSERT_EQ(ref_any_cast<std::vector<std::string>>(ref1.GetProperty(Constants::OBJECTCLASS)),
+              std::vector<std::string> { us_service_interface_iid<ITestServiceA>() });
+
+    reg1.Unregister();
+}
+
+TEST_F(ServiceRegistryTest, TestServicePropertiesCaseVariants)
+{
+    auto s1 = std::make_shared<TestServiceA>();
+
+    // case variants of user supplied keys
+    ServiceProperties variants;
+    variants["key"] = std::string("a");
+    variants["KEY"] = std::string("b");
+    EXPECT_THROW((void)context.RegisterService<ITestServiceA>(s1, std::move(variants)), std::runtime_error);
+
+    // case variants of the keys added by the framework
+    ServiceProperties props;
+    props["Service.Scope"] = std::string("custom");
+    EXPECT_THROW((void)context.RegisterService<ITestServiceA>(s1, props), std::runtime_error);
+    EXPECT_THROW((void)context.RegisterService<ITestServiceA>(s1, std::move(props)), std::runtime_error);
+
+    ServiceRegistration<ITestServiceA> reg1 = context.RegisterService<ITestServiceA>(s1);
+    auto id = any_cast<long>(reg1.GetReference().GetProperty(Constants::SERVICE_ID));
+    ServiceProperties props2;
+    props2["SERVICE.ID"] = 42L;
+    EXPECT_THROW(reg1.SetProperties(props2), std::runtime_error);
+    ASSERT_EQ(any_cast<long>(reg1.GetReference().GetProperty(Constants::SERVICE_ID)), id);
+
+    reg1.Unregister();
+}
+
+TEST_F(ServiceRegistryTest, TestConcurrentSingletonGetService)
+{
+    auto s1 = std::make_shared<TestServiceA>();
+    ServiceRegistration<ITestServiceA> reg1 = context.RegisterService<ITestServiceA>(s1);
+    ServiceReference<ITestServiceA> ref1 = reg1.GetReference();
+
+    auto held = context.GetService(ref1);
+    ASSERT_EQ(held, s1);
+
+    std::vector<std::future<bool>> results;
+    for (int t = 0; t < 16; ++t)
+    {
+        results.push_back(std::async(std::launch::async,
+                                     [this, &ref1, &s1]()
+                                     {
+                                         bool same = true;
+                                         for (int i = 0; i < 1000; ++i)
+                                         {
+                                             auto svc = context.GetService(ref1);
+                                             same = same && (svc == s1);
+                                         }
+                                         return same;
+                                     }));
+    }
+    for (auto& result : results)
+    {
+        ASSERT_TRUE(result.get());
+    }
+
+    // the bundle still uses the service through the held object
+    auto usingBundles = ref1.GetUsingBundles();
+    ASSERT_EQ(usingBundles.size(), 1);
+    ASSERT_EQ(usingBundles.front(), context.GetBundle());
+
+    held.reset();
+    ASSERT_TRUE(ref1.GetUsingBundles().empty());
+
+    // use the service again after it has been fully released
+    held = context.GetService(ref1);
+    ASSERT_EQ(held, s1);
+    ASSERT_EQ(ref1.GetUsingBundles().size(), 1);
+
+    reg1.Unregister();
+    ASSERT_TRUE(ref1.GetUsingBundles().empty());
+}
+
+TEST_F(ServiceRegistryTest, TestServicesInUseFollowUsage)
+{
+    auto s1 = std::make_shared<TestServiceA>();
+    auto s2 = std::make_shared<TestServiceA>();
+    auto reg1 = context.RegisterService<ITestServiceA>(s1);
+    auto reg2 = context.RegisterService<ITestServiceA>(s2);
+    auto ref1 = reg1.GetReference();
+    auto ref2 = reg2.GetReference();
+
+    // services in use are reported in registration order
+    auto svc2 = context.GetService(ref2);
+    auto svc1 = context.GetService(ref1);
+    auto inUse = context.GetBundle().GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 2);
+    ASSERT_EQ(inUse[0], ref1);
+    ASSERT_EQ(inUse[1], ref2);
+
+    svc1.reset();
+    inUse = context.GetBundle().GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 1);
+    ASSERT_EQ(inUse[0], ref2);
+
+    // using a released service again is reported again
+    svc1 = context.GetService(ref1);
+    ASSERT_EQ(context.GetBundle().GetServicesInUse().size(), 2);
+
+    reg2.Unregister();
+    inUse = context.GetBundle().GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 1);
+    ASSERT_EQ(inUse[0], ref1);
+}
+
+namespace
+{
+    // Records the order in which a bundle releases its services
+    class RecordingFactory : public ServiceFactory
+    {
+      public:
+        RecordingFactory(int id, std::vector<int>& released) : id(id), released(released) {}
+
+        InterfaceMapConstPtr
+        GetService(Bundle const&, ServiceRegistrationBase const&) override
+        {
+            return MakeInterfaceMap<ITestServiceA>(std::make_shared<TestServiceA>());
+        }
+
+        void
+        UngetService(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&) override
+        {
+            released.push_back(id);
+        }
+
+      private:
+        int id;
+        std::vector<int>& released;
+    };
+} // namespace
+
+TEST_F(ServiceRegistryTest, TestStoppedBundleReleasesServicesInRegistrationOrder)
+{
+    std::vector<int> released;
+    std::vector<ServiceRegistration<ITestServiceA>> regs;
+    for (int i = 0; i < 20; ++i)
+    {
+        regs.push_back(context.RegisterService<ITestServiceA>(ToFactory(std::make_shared<RecordingFactory>(i, released))));
+    }
+
+    auto bundle = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+    bundle.Start();
+    auto bundleContext = bundle.GetBundleContext();
+    // use the services in reverse registration order
+    std::vector<std::shared_ptr<ITestServiceA>> services;
+    for (auto reg = regs.rbegin(); reg != regs.rend(); ++reg)
+    {
+        services.push_back(bundleContext.GetService(reg->GetReference()));
+        ASSERT_TRUE(services.back());
+    }
+
+    bundle.Stop();
+    std::vector<int> expected(regs.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    ASSERT_EQ(released, expected);
+}
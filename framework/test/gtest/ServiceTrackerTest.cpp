@@ -379,6 +379,100 @@ TEST_F(ServiceTrackerTestFixture, GetTrackingCount)
     ASSERT_EQ(tracker.GetTrackingCount(), -1);
 }
 
+TEST_F(ServiceTrackerTestFixture, GetServiceFollowsHighestRanking)
+{
+    BundleContext context = framework.GetBundleContext();
+    cppmicroservices::ServiceTracker<MyInterfaceOne> tracker(context);
+
+    struct MyServiceOne : public MyInterfaceOne
+    {
+    };
+    auto s1 = std::make_shared<MyServiceOne>();
+    auto s2 = std::make_shared<MyServiceOne>();
+    auto s3 = std::make_shared<MyServiceOne>();
+
+    auto reg1 = context.RegisterService<MyInterfaceOne>(s1);
+    tracker.Open();
+    ASSERT_EQ(tracker.GetService(), s1);
+    ASSERT_EQ(tracker.GetServiceReference(), reg1.GetReference());
+
+    // same ranking, the lower service id wins
+    auto reg2 = context.RegisterService<MyInterfaceOne>(s2);
+    ASSERT_EQ(tracker.GetService(), s1);
+
+    auto reg3 = context.RegisterService<MyInterfaceOne>(s3, { { Constants::SERVICE_RANKING, Any(5) } });
+    ASSERT_EQ(tracker.GetService(), s3);
+    ASSERT_EQ(tracker.GetServiceReference(), reg3.GetReference());
+
+    reg2.SetProperties({ { Constants::SERVICE_RANKING, Any(10) } });
+    ASSERT_EQ(tracker.GetService(), s2);
+
+    reg2.SetProperties({ { Constants::SERVICE_RANKING, Any(1) } });
+    ASSERT_EQ(tracker.GetService(), s3);
+
+    reg3.Unregister();
+    ASSERT_EQ(tracker.GetService(), s2);
+
+    reg2.Unregister();
+    ASSERT_EQ(tracker.GetService(), s1);
+
+    tracker.Close();
+    ASSERT_EQ(tracker.GetService(), nullptr);
+    ASSERT_THROW(tracker.GetServiceReference(), ServiceException);
+
+    tracker.Open();
+    ASSERT_EQ(tracker.GetService(), s1);
+
+    reg1.Unregister();
+    ASSERT_EQ(tracker.GetService(), nullptr);
+    ASSERT_THROW(tracker.GetServiceReference(), ServiceException);
+    tracker.Close();
+}
+
+TEST_F(ServiceTrackerTestFixture, GetServicesOrderedByRanking)
+{
+    BundleContext context = framework.GetBundleContext();
+    cppmicroservices::ServiceTracker<MyInterfaceOne> tracker(context);
+    tracker.Open();
+
+    struct MyServiceOne : public MyInterfaceOne
+    {
+    };
+    auto s1 = std::make_shared<MyServiceOne>();
+    auto s2 = std::make_shared<MyServiceOne>();
+    auto s3 = std::make_shared<MyServiceOne>();
+    auto s4 = std::make_shared<MyServiceOne>();
+
+    auto reg1 = context.RegisterService<MyInterfaceOne>(s1);
+    auto reg2 = context.RegisterService<MyInterfaceOne>(s2, { { Constants::SERVICE_RANKING, Any(3) } });
+    auto reg3 = context.RegisterService<MyInterfaceOne>(s3);
+    auto reg4 = context.RegisterService<MyInterfaceOne>(s4, { { Constants::SERVICE_RANKING, Any(-1) } });
+
+    using Services = std::vector<std::shared_ptr<MyInterfaceOne>>;
+    ASSERT_EQ(tracker.GetServices(), (Services { s2, s1, s3, s4 }));
+    // unchanged tracker returns the same result
+    ASSERT_EQ(tracker.GetServices(), (Services { s2, s1, s3, s4 }));
+    ASSERT_EQ(tracker.GetServiceReferences(),
+              (std::vector<ServiceReference<MyInterfaceOne>> { reg2.GetReference(),
+                                                               reg1.GetReference(),
+                                                               reg3.GetReference(),
+                                                               reg4.GetReference() }));
+
+    reg4.SetProperties({ { Constants::SERVICE_RANKING, Any(10) } });
+    ASSERT_EQ(tracker.GetServices(), (Services { s4, s2, s1, s3 }));
+
+    reg2.Unregister();
+    ASSERT_EQ(tracker.GetServices(), (Services { s4, s1, s3 }));
+
+    std::unordered_map<ServiceReference<MyInterfaceOne>, std::shared_ptr<MyInterfaceOne>> tracked;
+    tracker.GetTracked(tracked);
+    ASSERT_EQ(tracked.size(), 3ul);
+    ASSERT_EQ(tracked[reg1.GetReference()], s1);
+
+    tracker.Close();
+    ASSERT_TRUE(tracker.GetServices().empty());
+}
+
 TEST_F(ServiceTrackerTestFixture, GetTracked)
 {
     BundleContext context = framework.GetBundleContext();
@@ -686,6 +780,34 @@ TEST_F(ServiceTrackerTestFixture, TestFilterPropertiesTypes)
     tracker.Close();
 }
 
+/// <summary>
+/// a service object removed from the tracker must not be kept alive by the
+/// tracker's cached snapshot.
+/// </summary>
+TEST_F(ServiceTrackerTestFixture, TestSnapshotReleasesUntrackedServices)
+{
+    auto context = framework.GetBundleContext();
+    ServiceTracker<MyInterfaceOne> tracker(context);
+    tracker.Open();
+
+    struct MyServiceOne : public MyInterfaceOne
+    {
+    };
+    auto service = std::make_shared<MyServiceOne>();
+    std::weak_ptr<MyServiceOne> weakService = service;
+    auto svcReg = context.RegisterService<MyInterfaceOne>(service);
+    service.reset();
+
+    // populate the snapshot
+    ASSERT_EQ(tracker.GetServices().size(), 1);
+
+    svcReg.Unregister();
+    EXPECT_TRUE(weakService.expired()) << "untracked service must be released";
+    EXPECT_TRUE(tracker.GetServices().empty());
+
+    tracker.Close();
+}
+
 #ifdef US_ENABLE_THREADING_SUPPORT
 
 TEST(ServiceTrackerTests, TestServiceTrackerDeadlock)
@@ -26,6 +26,9 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+
 using namespace cppmicroservices;
 using namespace cppmicroservices::testing;
 using namespace cppmicroservices::util;
@@ -164,3 +167,32 @@ TEST_F(UtilsFs, MakeAndRemovePath)
     ASSERT_NO_THROW(MakePath(validPath));
     ASSERT_NO_THROW(RemoveDirectoryRecursive(validPath));
 }
+
+TEST_F(UtilsFs, GetFileStat)
+{
+    std::uint64_t size = 0;
+    std::int64_t modifiedTime = 0;
+    std::uint64_t fileId = 0;
+    EXPECT_FALSE(GetFileStat("not a file", size, modifiedTime, fileId));
+
+    // Replace a file by one of the same size, as an update of a bundle file
+    // within the timestamp resolution would.
+    const std::string path = TempDir.Path + DIR_SEP + "stat";
+    const std::string replacement = path + ".new";
+    std::ofstream(path) << "first";
+    ASSERT_TRUE(GetFileStat(path, size, modifiedTime, fileId));
+    EXPECT_EQ(size, 5u);
+    EXPECT_GT(modifiedTime, 0);
+
+    std::ofstream(replacement) << "other";
+    std::remove(path.c_str());
+    ASSERT_EQ(std::rename(replacement.c_str(), path.c_str()), 0);
+    std::uint64_t newSize = 0;
+    std::int64_t newModifiedTime = 0;
+    std::uint64_t newFileId = 0;
+    ASSERT_TRUE(GetFileStat(path, newSize, newModifiedTime, newFileId));
+    EXPECT_EQ(newSize, size);
+#ifndef US_PLATFORM_WINDOWS
+    EXPECT_NE(newFileId, fileId) << "The replaced file kept its file id";
+#endif
+}
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
@@ -313,6 +314,152 @@ namespace
         std::clog << "final (validated) manifest.json:\n" << manifestJson.toStyledString() << std::endl;
         return manifestJson;
     }
+    /*
+     * Binary manifest format, read by the framework's BundleManifest::ParseBinary.
+     *
+     * The signature "USBM" and a format version byte are followed by the root
+     * object. Each value is a one byte tag followed by its payload: nothing for
+     * booleans, a 32 bit little endian integer, a 64 bit little endian IEEE 754
+     * double, or a length/count and the string bytes, array elements or object
+     * members (key length, key bytes, value). Lengths and counts are unsigned
+     * LEB128 numbers.
+     */
+    char const BINARY_MANIFEST_SIGNATURE[] = { 'U', 'S', 'B', 'M' };
+    unsigned char const BINARY_MANIFEST_VERSION = 1;
+
+    enum BinaryManifestTag : unsigned char
+    {
+        BINARY_FALSE = 1,
+        BINARY_TRUE = 2,
+        BINARY_INT = 3,
+        BINARY_DOUBLE = 4,
+        BINARY_STRING = 5,
+        BINARY_ARRAY = 6,
+        BINARY_OBJECT = 7
+    };
+
+    /*
+     * @brief checks whether a JSON value is kept when the framework parses manifest.json.
+     * Null values and integers which do not fit into an int are dropped there, so they
+     * are not written to the binary manifest either.
+     */
+    bool
+    isBinaryManifestValue(Json::Value const& value)
+    {
+        switch (value.type())
+        {
+            case Json::nullValue:
+                return false;
+            case Json::intValue:
+            case Json::uintValue:
+                return value.isInt();
+            default:
+                return true;
+        }
+    }
+
+    void
+    writeBinaryCount(std::uint64_t count, std::string& out)
+    {
+        do
+        {
+            unsigned char byte = count & 0x7f;
+            count >>= 7;
+            if (count != 0)
+            {
+                byte |= 0x80;
+            }
+            out.push_back(static_cast<char>(byte));
+        } while (count != 0);
+    }
+
+    void
+    writeBinaryLittleEndian(std::uint64_t value, std::size_t size, std::string& out)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    void
+    writeBinaryString(std::string const& value, std::string& out)
+    {
+        writeBinaryCount(value.size(), out);
+        out.append(value);
+    }
+
+    void
+    writeBinaryManifestValue(Json::Value const& value, std::string& out)
+    {
+        switch (value.type())
+        {
+            case Json::booleanValue:
+                out.push_back(static_cast<char>(value.asBool() ? BINARY_TRUE : BINARY_FALSE));
+                break;
+            case Json::intValue:
+            case Json::uintValue:
+                out.push_back(static_cast<char>(BINARY_INT));
+                writeBinaryLittleEndian(static_cast<std::uint32_t>(value.asInt()), 4, out);
+                break;
+            case Json::realValue:
+            {
+                double const number = value.asDouble();
+                std::uint64_t bits;
+                memcpy(&bits, &number, sizeof bits);
+                out.push_back(static_cast<char>(BINARY_DOUBLE));
+                writeBinaryLittleEndian(bits, 8, out);
+                break;
+            }
+            case Json::stringValue:
+                out.push_back(static_cast<char>(BINARY_STRING));
+                writeBinaryString(value.asString(), out);
+                break;
+            case Json::arrayValue:
+            {
+                out.push_back(static_cast<char>(BINARY_ARRAY));
+                writeBinaryCount(std::count_if(value.begin(), value.end(), isBinaryManifestValue), out);
+                for (auto const& element : value)
+                {
+                    if (isBinaryManifestValue(element))
+                    {
+                        writeBinaryManifestValue(element, out);
+                    }
+                }
+                break;
+            }
+            case Json::objectValue:
+            {
+                out.push_back(static_cast<char>(BINARY_OBJECT));
+                writeBinaryCount(std::count_if(value.begin(), value.end(), isBinaryManifestValue), out);
+                for (auto iter = value.begin(); iter != value.end(); ++iter)
+                {
+                    if (isBinaryManifestValue(*iter))
+                    {
+                        writeBinaryString(iter.name(), out);
+                        writeBinaryManifestValue(*iter, out);
+                    }
+                }
+                break;
+            }
+            case Json::nullValue:
+                break;
+        }
+    }
+
+    /*
+     * @brief converts a validated manifest into the binary manifest format.
+     * @param manifest the JSON root object of the manifest.
+     * @return the binary manifest
+     */
+    std::string
+    makeBinaryManifest(Json::Value const& manifest)
+    {
+        std::string out(BINARY_MANIFEST_SIGNATURE, sizeof(BINARY_MANIFEST_SIGNATURE));
+        out.push_back(static_cast<char>(BINARY_MANIFEST_VERSION));
+        writeBinaryManifestValue(manifest, out);
+        return out;
+    }
 } // namespace
 
 /*
@@ -321,7 +468,10 @@ namespace
 class ZipArchive
 {
   public:
-    ZipArchive(std::string const& archiveFileName, int compressionLevel, std::string const& bundleName);
+    ZipArchive(std::string const& archiveFileName,
+               int compressionLevel,
+               std::string const& bundleName,
+               bool binaryManifest = false);
     virtual ~ZipArchive();
     /*
      * @brief Add manifest.json to this zip archive
@@ -361,6 +511,13 @@ class ZipArchive
      */
     void AddDirectory(std::string const& dirName);
 
+    /*
+     * @brief Add manifest.bin, the binary form of the manifest, if requested
+     * @param manifest the validated manifest
+     * @throw std::runtime exception if failed to add manifest.bin
+     */
+    void AddBinaryManifest(Json::Value const& manifest);
+
     /*
      * @brief Checks whether the archive file entry already
      *        exists in the zip archive. If it does, throw an exception.
@@ -378,15 +535,20 @@ class ZipArchive
     std::string fileName;
     int compressionLevel;
     std::string bundleName;
+    bool binaryManifest;
     std::unique_ptr<mz_zip_archive> writeArchive;
     std::set<std::string> archivedNames; // list of all the file entries
     std::set<std::string> archivedDirs;  // list of all directory entries
 };
 
-ZipArchive::ZipArchive(std::string const& archiveFileName, int compressionLevel, std::string const& bName)
+ZipArchive::ZipArchive(std::string const& archiveFileName,
+                       int compressionLevel,
+                       std::string const& bName,
+                       bool binaryManifest)
     : fileName(archiveFileName)
     , compressionLevel(compressionLevel)
     , bundleName(bName)
+    , binaryManifest(binaryManifest)
     , writeArchive(new mz_zip_archive())
 {
     std::clog << "Initializing zip archive " << fileName << " ..." << std::endl;
@@ -427,9 +589,35 @@ ZipArchive::AddManifestFile(Json::Value const& manifest)
     {
         throw std::runtime_error("Error writing manifest.json to archive " + fileName);
     }
+    AddBinaryManifest(manifest);
     AddDirectory(bundleName + "/");
 }
 
+void
+ZipArchive::AddBinaryManifest(Json::Value const& manifest)
+{
+    if (!binaryManifest)
+    {
+        return;
+    }
+
+    std::string binary(makeBinaryManifest(manifest));
+    std::string archiveEntry(bundleName + "/manifest.bin");
+
+    CheckAndAddToArchivedNames(archiveEntry);
+
+    // Stored uncompressed so that the framework can read it in place.
+    if (MZ_FALSE
+        == mz_zip_writer_add_mem(writeArchive.get(),
+                                 archiveEntry.c_str(),
+                                 binary.data(),
+                                 binary.size(),
+                                 MZ_NO_COMPRESSION))
+    {
+        throw std::runtime_error("Error writing manifest.bin to archive " + fileName);
+    }
+}
+
 void
 ZipArchive::AddResourceFile(std::string const& resFileName, bool isManifest)
 {
@@ -437,9 +625,10 @@ ZipArchive::AddResourceFile(std::string const& resFileName, bool isManifest)
 
     // This check exists solely to maintain a deprecated way of adding manifest.json
     // through the --res-add option.
-    if (isManifest || resFileName == std::string("manifest.json"))
+    Json::Value root;
+    bool const manifest = isManifest || resFileName == std::string("manifest.json");
+    if (manifest)
     {
-        Json::Value root;
         parseAndValidateJsonFromFile(resFileName, root);
     }
 
@@ -462,6 +651,10 @@ ZipArchive::AddResourceFile(std::string const& resFileName, bool isManifest)
     {
         throw std::runtime_error("Error writing file to archive");
     }
+    if (manifest)
+    {
+        AddBinaryManifest(root);
+    }
     // add a directory entries for the file path
     size_t lastPathSeparatorPos = archiveEntry.find("/", 0);
     while (lastPathSeparatorPos != std::string::npos)
@@ -635,7 +828,8 @@ enum OptionIndex
     RESADD,
     ZIPADD,
     MANIFESTADD,
-    BUNDLEFILE
+    BUNDLEFILE,
+    BINARYMANIFEST
 };
 
 const option::Descriptor usage[] = {
@@ -682,6 +876,11 @@ const option::Descriptor usage[] = {
      "bundle-file", Custom_Arg::NonEmpty,
      " --bundle-file, -b \tPath to the bundle binary. The resources zip file "
      "will be appended to this binary. "                                                                  },
+    {  BINARYMANIFEST,
+     0,  "",
+     "binary-manifest",     Custom_Arg::None,
+     " --binary-manifest \tAlso add the bundle manifest in a pre-parsed binary "
+     "form (manifest.bin), which the framework loads instead of parsing manifest.json."                   },
     {         UNKNOWN,
      0,  "",
      "",     Custom_Arg::None,
@@ -836,6 +1035,7 @@ main(int argc, char** argv)
     {
         bundleName = options[BUNDLENAME].arg;
     }
+    bool const binaryManifest = options[BINARYMANIFEST];
 
     if (!options[VERBOSE])
     {
@@ -876,7 +1076,7 @@ main(int argc, char** argv)
                 deleteTempFile = true;
             }
 
-            std::unique_ptr<ZipArchive> zipArchive(new ZipArchive(zipFile, compressionLevel, bundleName));
+            std::unique_ptr<ZipArchive> zipArchive(new ZipArchive(zipFile, compressionLevel, bundleName, binaryManifest));
 
             // map of manifest file to its JSON data
             std::unordered_map<std::string, Json::Value> manifests;
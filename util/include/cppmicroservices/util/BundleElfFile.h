@@ -28,12 +28,11 @@
 #    include <cerrno>
 #    include <cstring>
 #    include <elf.h>
-#    include <fstream>
-#    include <map>
 #    include <memory>
 #    include <new>
 
 #    include <sys/stat.h>
+#    include <unistd.h>
 
 namespace cppmicroservices
 {
@@ -89,75 +88,98 @@ namespace cppmicroservices
         }
     };
 
+    /// The location of the .us_resources section within an ELF file. A size
+    /// of zero means the file has no (or an empty) resource section.
+    struct ElfResourceSection
+    {
+        off_t offset = 0;
+        std::size_t size = 0;
+    };
+
     template <class ElfType>
-    class BundleElfFile
-        : public BundleObjFile
-        , private ElfType
+    struct ElfHeaders
     {
-      public:
         typedef typename ElfType::Ehdr Ehdr;
         typedef typename ElfType::Shdr Shdr;
-        typedef typename ElfType::Dyn Dyn;
-        typedef typename ElfType::Addr Addr;
-        typedef typename ElfType::Sym Sym;
 
-        typedef typename ElfType::Half Half;
-        typedef typename ElfType::Word Word;
-        typedef typename ElfType::Off Off;
-
-        BundleElfFile(std::ifstream& fs, std::size_t fileSize, std::string const& fileName) : m_rawData()
+        /// Locate the .us_resources section by parsing the ELF header, the
+        /// section headers and the section string table of a memory mapped file.
+        static ElfResourceSection
+        FindResourceSection(char const* data, std::size_t fileSize)
         {
             if (fileSize < sizeof(Ehdr))
             {
                 throw InvalidElfException("Missing ELF header");
             }
 
-            fs.seekg(0);
-
-            // Read the ELF header
+            // The mapping is page aligned, the headers are copied nevertheless
+            // so that no assumptions about their alignment within the file are made.
             Ehdr elfHeader;
-            fs.read(reinterpret_cast<char*>(&elfHeader), sizeof elfHeader);
+            std::memcpy(&elfHeader, data, sizeof elfHeader);
 
             if (elfHeader.e_type != ET_DYN)
             {
                 throw InvalidElfException("Not an ELF shared library");
             }
 
-            if (elfHeader.e_shoff + (elfHeader.e_shnum * elfHeader.e_shentsize) > fileSize)
+            if (elfHeader.e_shentsize < sizeof(Shdr)
+                || elfHeader.e_shoff + (elfHeader.e_shnum * elfHeader.e_shentsize) > fileSize)
             {
                 throw InvalidElfException("ELF section headers missing");
             }
 
-            // read in all section headers
-            auto sectionHeaders = std::make_unique<Shdr[]>(elfHeader.e_shnum);
-            fs.seekg(elfHeader.e_shoff);
-            fs.read(reinterpret_cast<char*>(sectionHeaders.get()), sizeof(Shdr) * elfHeader.e_shnum);
+            auto sectionHeader = [&](std::size_t index)
+            {
+                Shdr header;
+                std::memcpy(&header, data + elfHeader.e_shoff + index * elfHeader.e_shentsize, sizeof header);
+                return header;
+            };
 
-            // parse the .us_resources section
-            // keep the buffer in a smart pointer to correctly clean up at end
-            // of scope even if exceptions occur.
-            auto buffer = std::make_unique<char[]>(sectionHeaders[elfHeader.e_shstrndx].sh_size);
-            if (nullptr != buffer)
+            ElfResourceSection section;
+            if (elfHeader.e_shstrndx >= elfHeader.e_shnum)
             {
-                fs.seekg(sectionHeaders[elfHeader.e_shstrndx].sh_offset);
-                fs.read(buffer.get(), sectionHeaders[elfHeader.e_shstrndx].sh_size);
+                return section;
+            }
+
+            auto const stringTable = sectionHeader(elfHeader.e_shstrndx);
+            if (stringTable.sh_offset > fileSize || stringTable.sh_size > fileSize - stringTable.sh_offset)
+            {
+                throw InvalidElfException("ELF section string table missing");
+            }
+            char const* names = data + stringTable.sh_offset;
 
-                for (int i = 0; i < elfHeader.e_shnum; ++i)
+            static char const resourceSectionName[] = ".us_resources";
+            for (std::size_t i = 0; i < elfHeader.e_shnum; ++i)
+            {
+                auto const header = sectionHeader(i);
+                if (header.sh_name >= stringTable.sh_size
+                    || stringTable.sh_size - header.sh_name < sizeof resourceSectionName
+                    || 0 != std::memcmp(resourceSectionName, names + header.sh_name, sizeof resourceSectionName))
                 {
-                    if (0 == strcmp(".us_resources", (buffer.get() + sectionHeaders[i].sh_name)))
-                    {
-                        fs.seekg(sectionHeaders[i].sh_offset);
-                        auto zipContentSize = sectionHeaders[i].sh_size;
-                        if (0 < zipContentSize)
-                        {
-                            off_t pa_offset = (sectionHeaders[i].sh_offset) & ~(sysconf(_SC_PAGESIZE) - 1);
-                            size_t mappedLength = zipContentSize + (sectionHeaders[i].sh_offset) - pa_offset;
-                            m_rawData = std::make_shared<RawBundleResources>(
-                                std::make_unique<MappedFile>(fileName, mappedLength, pa_offset));
-                            break;
-                        }
-                    }
+                    continue;
                 }
+                if (0 < header.sh_size && header.sh_offset <= fileSize && header.sh_size <= fileSize - header.sh_offset)
+                {
+                    section.offset = static_cast<off_t>(header.sh_offset);
+                    section.size = static_cast<std::size_t>(header.sh_size);
+                    break;
+                }
+            }
+            return section;
+        }
+    };
+
+    class BundleElfFile : public BundleObjFile
+    {
+      public:
+        BundleElfFile(std::string const& fileName, ElfResourceSection const& section) : m_rawData()
+        {
+            if (0 < section.size)
+            {
+                off_t pa_offset = section.offset & ~(sysconf(_SC_PAGESIZE) - 1);
+                size_t mappedLength = section.size + section.offset - pa_offset;
+                m_rawData = std::make_shared<RawBundleResources>(
+                    std::make_unique<MappedFile>(fileName, mappedLength, pa_offset));
             }
         }
 
@@ -171,56 +193,66 @@ namespace cppmicroservices
         std::shared_ptr<RawBundleResources> m_rawData;
     };
 
-    std::unique_ptr<BundleObjFile>
-    CreateBundleElfFile(std::string const& fileName)
+    /// Find the .us_resources section of the ELF file at the given location,
+    /// reading all headers through a single read-only mapping of the file.
+    ///
+    /// @param fileName path to an ELF shared library.
+    /// @param fileSize the size of the file in bytes, as reported by stat.
+    /// @throws InvalidElfException if the file is not a valid ELF shared library.
+    inline ElfResourceSection
+    FindElfResourceSection(std::string const& fileName, std::size_t fileSize)
     {
-        struct stat elfStat;
-        errno = 0;
-        if (stat(fileName.c_str(), &elfStat) != 0)
-        {
-            throw InvalidElfException("Stat for " + fileName + " failed", errno);
-        }
-
-        std::size_t fileSize = elfStat.st_size;
-
         if (fileSize < EI_NIDENT)
         {
             throw InvalidElfException("Missing ELF identification");
         }
 
-        std::ifstream elfFile(fileName.c_str(), std::ios_base::binary);
-        elfFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-        char elfIdent[EI_NIDENT];
-        elfFile.read(elfIdent, sizeof elfIdent);
-
-        if (memcmp(elfIdent, ELFMAG, SELFMAG) != 0)
+        MappedFile elfFile(fileName, fileSize, 0);
+        auto const* data = static_cast<char const*>(elfFile.GetData());
+        if (nullptr == data)
         {
-            throw InvalidElfException("Not an ELF object file");
+            throw InvalidElfException("Mapping " + fileName + " failed", errno);
         }
 
-        std::ifstream selfFile(fileName, std::ios_base::binary);
-        char selfIdent[EI_NIDENT];
-        selfFile.read(selfIdent, sizeof selfIdent);
-        selfFile.close();
-        if (memcmp(elfIdent, selfIdent, EI_VERSION) != 0)
+        if (memcmp(data, ELFMAG, SELFMAG) != 0)
         {
-            throw InvalidElfException("Not a compatible ELF object file");
+            throw InvalidElfException("Not an ELF object file");
         }
 
-        if (elfIdent[EI_CLASS] == ELFCLASS32)
+        if (data[EI_CLASS] == ELFCLASS32)
         {
-            return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS32>>(elfFile, fileSize, fileName));
+            return ElfHeaders<Elf<ELFCLASS32>>::FindResourceSection(data, fileSize);
         }
-        else if (elfIdent[EI_CLASS] == ELFCLASS64)
+        else if (data[EI_CLASS] == ELFCLASS64)
         {
-            return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS64>>(elfFile, fileSize, fileName));
+            return ElfHeaders<Elf<ELFCLASS64>>::FindResourceSection(data, fileSize);
         }
         else
         {
             throw InvalidElfException("Unknown ELF format");
         }
     }
+
+    /// Create a BundleObjFile for a .us_resources section located earlier
+    /// by FindElfResourceSection, without parsing the ELF headers again.
+    inline std::unique_ptr<BundleObjFile>
+    CreateBundleElfFile(std::string const& fileName, ElfResourceSection const& section)
+    {
+        return std::make_unique<BundleElfFile>(fileName, section);
+    }
+
+    inline std::unique_ptr<BundleObjFile>
+    CreateBundleElfFile(std::string const& fileName)
+    {
+        struct stat elfStat;
+        errno = 0;
+        if (stat(fileName.c_str(), &elfStat) != 0)
+        {
+            throw InvalidElfException("Stat for " + fileName + " failed", errno);
+        }
+
+        return CreateBundleElfFile(fileName, FindElfResourceSection(fileName, elfStat.st_size));
+    }
 } // namespace cppmicroservices
 
 #endif
@@ -42,6 +42,11 @@ namespace cppmicroservices
         ///
         /// @note The location must be a valid binary format for the host machine.
         ///       i.e. PE file on Windows, Mach-O on macOS, ELF on Linux
+        ///
+        /// @note On Linux, the location of the resource section is cached per path
+        ///       and reused as long as the file's device, inode, size and
+        ///       modification time are unchanged. The cache keeps the most
+        ///       recently used locations only.
         std::unique_ptr<BundleObjFile> CreateBundleFileObj(std::string const& location);
     };
 
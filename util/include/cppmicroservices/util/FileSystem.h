@@ -23,6 +23,7 @@
 #ifndef CPPMICROSERVICES_UTIL_FILESYSTEM_H
 #define CPPMICROSERVICES_UTIL_FILESYSTEM_H
 
+#include <cstdint>
 #include <string>
 
 namespace cppmicroservices
@@ -48,6 +49,17 @@ namespace cppmicroservices
 
         bool IsDirectory(std::string const& path);
         bool IsFile(std::string const& path);
+
+        // Get the size in bytes, the last modification time in nanoseconds
+        // since the epoch and the file id (inode number, zero on Windows) of
+        // the file at path. The modification time has second resolution on
+        // platforms without sub-second timestamps. Returns false if the file
+        // does not exist.
+        bool GetFileStat(std::string const& path,
+                         std::uint64_t& size,
+                         std::int64_t& modifiedTime,
+                         std::uint64_t& fileId);
+
         bool IsRelative(std::string const& path);
 
         std::string GetAbsolute(std::string const& path, std::string const& base);
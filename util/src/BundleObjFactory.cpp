@@ -26,9 +26,113 @@ Library: CppMicroServices
 #include "cppmicroservices/util/BundleObjFile.h"
 #include "cppmicroservices/util/BundlePEFile.h"
 
+#if defined(US_PLATFORM_LINUX)
+#    include <list>
+#    include <mutex>
+#    include <unordered_map>
+#endif
+
 namespace cppmicroservices
 {
 
+#if defined(US_PLATFORM_LINUX)
+    namespace
+    {
+        // The location of the resource section of a previously parsed ELF file,
+        // valid for as long as the file's identity and modification time do not change.
+        struct CachedElfResourceSection
+        {
+            dev_t device;
+            ino_t inode;
+            off_t size;
+            struct timespec modified;
+            ElfResourceSection section;
+
+            bool
+            Matches(struct stat const& fileStat) const
+            {
+                return device == fileStat.st_dev && inode == fileStat.st_ino && size == fileStat.st_size
+                       && modified.tv_sec == fileStat.st_mtim.tv_sec && modified.tv_nsec == fileStat.st_mtim.tv_nsec;
+            }
+        };
+
+        /// A least recently used cache of ELF resource section locations,
+        /// bounded so that installing many distinct libraries over the
+        /// lifetime of a process does not grow it indefinitely.
+        class ElfSectionCache
+        {
+          public:
+            static constexpr std::size_t MaxEntries = 1024;
+
+            bool
+            Find(std::string const& location, struct stat const& fileStat, ElfResourceSection& section)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto iter = index.find(location);
+                if (iter == index.end() || !iter->second->second.Matches(fileStat))
+                {
+                    return false;
+                }
+                entries.splice(entries.begin(), entries, iter->second);
+                section = iter->second->second.section;
+                return true;
+            }
+
+            void
+            Insert(std::string const& location, CachedElfResourceSection const& cached)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto iter = index.find(location);
+                if (iter != index.end())
+                {
+                    iter->second->second = cached;
+                    entries.splice(entries.begin(), entries, iter->second);
+                    return;
+                }
+
+                if (entries.size() >= MaxEntries)
+                {
+                    index.erase(entries.back().first);
+                    entries.pop_back();
+                }
+                entries.emplace_front(location, cached);
+                index.emplace(location, entries.begin());
+            }
+
+          private:
+            using Entries = std::list<std::pair<std::string, CachedElfResourceSection>>;
+
+            std::mutex mutex;
+            // Most recently used first.
+            Entries entries;
+            std::unordered_map<std::string, Entries::iterator> index;
+        };
+
+        ElfSectionCache elfSectionCache;
+
+        std::unique_ptr<BundleObjFile>
+        CreateCachedBundleElfFile(std::string const& location)
+        {
+            struct stat elfStat;
+            errno = 0;
+            if (stat(location.c_str(), &elfStat) != 0)
+            {
+                throw InvalidElfException("Stat for " + location + " failed", errno);
+            }
+
+            ElfResourceSection section;
+            if (!elfSectionCache.Find(location, elfStat, section))
+            {
+                section = FindElfResourceSection(location, elfStat.st_size);
+                elfSectionCache.Insert(
+                    location,
+                    CachedElfResourceSection { elfStat.st_dev, elfStat.st_ino, elfStat.st_size, elfStat.st_mtim, section });
+            }
+            return CreateBundleElfFile(location, section);
+        }
+    } // namespace
+#endif
+
     /// Return a BundleObjFile which represents data read from the binary at
     /// the given location.
     ///
@@ -38,6 +142,11 @@ namespace cppmicroservices
     ///
     /// @note The location must be a valid binary format for the host machine.
     ///       i.e. PE file on Windows, Mach-O on macOS, ELF on Linux
+    ///
+    /// @note On Linux, the location of the resource section is cached per path
+    ///       and reused as long as the file's device, inode, size and
+    ///       modification time are unchanged. The cache keeps the most
+    ///       recently used locations only.
     std::unique_ptr<BundleObjFile>
     BundleObjFactory::CreateBundleFileObj(std::string const& location)
     {
@@ -46,7 +155,7 @@ namespace cppmicroservices
 #elif defined(US_PLATFORM_APPLE)
         return CreateBundleMachOFile(location);
 #elif defined(US_PLATFORM_LINUX)
-        return CreateBundleElfFile(location);
+        return CreateCachedBundleElfFile(location);
 #else
 #    error "Unknown OS platform";
 #endif
@@ -268,6 +268,32 @@ namespace cppmicroservices
             return S_ISREG(s.st_mode);
         }
 
+        bool
+        GetFileStat(std::string const& path, std::uint64_t& size, std::int64_t& modifiedTime, std::uint64_t& fileId)
+        {
+            US_STAT s;
+            errno = 0;
+            if (us_stat(path.c_str(), &s))
+            {
+                if (not_found_c_error(errno))
+                    return false;
+                else
+                    throw std::invalid_argument(GetLastCErrorStr());
+            }
+            size = static_cast<std::uint64_t>(s.st_size);
+#if defined(US_PLATFORM_APPLE)
+            modifiedTime = static_cast<std::int64_t>(s.st_mtimespec.tv_sec) * 1000000000
+                           + static_cast<std::int64_t>(s.st_mtimespec.tv_nsec);
+#elif defined(US_PLATFORM_POSIX)
+            modifiedTime = static_cast<std::int64_t>(s.st_mtim.tv_sec) * 1000000000
+                           + static_cast<std::int64_t>(s.st_mtim.tv_nsec);
+#else
+            modifiedTime = static_cast<std::int64_t>(s.st_mtime) * 1000000000;
+#endif
+            fileId = static_cast<std::uint64_t>(s.st_ino);
+            return true;
+        }
+
         bool
         IsRelative(std::string const& path)
         {